@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "s21_graph.h"
+#include "s21_mapped_file.h"
+#include "s21_text_parser.h"
+
+namespace s21 {
+
+namespace {
+
+// Calls function(begin, end) for every line of the text that is neither
+// blank nor a comment starting with one of the comment characters.
+template <typename Function>
+void ForEachLine(const char* first, const char* last, const char* comments,
+                 Function&& function) {
+  while (first != last) {
+    const char* end = static_cast<const char*>(
+        std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+    if (end == nullptr) end = last;
+    const char* begin = first;
+    while (begin != end && parser::IsSpace(*begin)) ++begin;
+    if (begin != end && std::strchr(comments, *begin) == nullptr) {
+      function(begin, end);
+    }
+    first = end == last ? last : end + 1;
+  }
+}
+
+// Parse "from to weight" with 1-based vertices, which must be all that is
+// left on the line.
+template <typename W>
+void ParseArc(const char* first, const char* last, std::size_t* from,
+              std::size_t* to, W* weight) {
+  first = parser::ParseNumber(first, last, from);
+  first = parser::ParseNumber(first, last, to);
+  first = parser::ParseNumber(first, last, weight);
+  if (*from == 0 || *to == 0 || parser::SkipSpaces(first, last) != last) {
+    throw std::runtime_error("Invalid graph file");
+  }
+}
+
+// Builds the graph in two passes over the arcs: the first one counts the
+// out-degrees, the second one writes every arc straight to its row. Arcs
+// are then sorted inside their row and duplicates collapse into the one
+// with the least weight, so nothing but the CSR arrays themselves grows
+// with the number of edges. read_arcs(add_arc) must call add_arc(from, to,
+// weight) with 0-based vertices for every arc and return the declared
+// amount of vertices (or 0 to use the largest vertex seen).
+template <typename W, typename ArcReader>
+BasicCsrMatrix<W> BuildCsr(ArcReader&& read_arcs) {
+  using index_type = typename BasicCsrMatrix<W>::index_type;
+
+  std::vector<std::size_t> offsets(1, 0);
+  std::size_t const declared_vertices =
+      read_arcs([&offsets](std::size_t from, std::size_t to, W) {
+        if (std::max(from, to) >= std::numeric_limits<index_type>::max()) {
+          throw std::runtime_error("Too many vertices");
+        }
+        std::size_t const rows = std::max(from, to) + 2;
+        if (offsets.size() < rows) offsets.resize(rows, 0);
+        offsets[from + 1]++;
+      });
+  std::size_t const vertices =
+      std::max(declared_vertices, offsets.size() - 1);
+  if (vertices >= std::numeric_limits<index_type>::max()) {
+    throw std::runtime_error("Too many vertices");
+  }
+  offsets.resize(vertices + 1, 0);
+  for (std::size_t i = 0; i < vertices; i++) offsets[i + 1] += offsets[i];
+
+  std::vector<index_type> columns(offsets[vertices]);
+  std::vector<W> values(offsets[vertices]);
+  std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+  read_arcs([&](std::size_t from, std::size_t to, W weight) {
+    columns[cursor[from]] = static_cast<index_type>(to);
+    values[cursor[from]] = weight;
+    cursor[from]++;
+  });
+  std::vector<std::size_t>().swap(cursor);
+
+  std::vector<std::pair<index_type, W>> row;
+  std::size_t written = 0;
+  for (std::size_t i = 0; i < vertices; i++) {
+    row.clear();
+    for (std::size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+      row.emplace_back(columns[k], values[k]);
+    }
+    std::sort(row.begin(), row.end());
+    offsets[i] = written;
+    for (std::size_t k = 0; k < row.size(); k++) {
+      if (k == 0 || row[k].first != row[k - 1].first) {
+        columns[written] = row[k].first;
+        values[written] = row[k].second;
+        written++;
+      }
+    }
+  }
+  offsets[vertices] = written;
+  columns.resize(written);
+  values.resize(written);
+
+  return BasicCsrMatrix<W>(vertices, vertices, std::move(offsets),
+                           std::move(columns), std::move(values));
+}
+
+}  // namespace
+
+template <typename W>
+void BasicGraph<W>::LoadGraphFromEdgeList(const std::string& filename,
+                                          bool undirected) {
+  MappedFile file(filename);
+  const char* const data = file.Data();
+  const char* const end = data + file.Size();
+
+  BasicGraph graph(BuildCsr<W>([data, end, undirected](auto&& add_arc) {
+    ForEachLine(data, end, "#%", [&](const char* first, const char* last) {
+      std::size_t from, to;
+      W weight;
+      ParseArc(first, last, &from, &to, &weight);
+      if (weight == kNoEdge) return;
+      add_arc(from - 1, to - 1, weight);
+      if (undirected && from != to) add_arc(to - 1, from - 1, weight);
+    });
+    return std::size_t(0);
+  }));
+  graph.StartNewLog(version_ + 1);
+  Swap(&graph);
+}
+
+template <typename W>
+void BasicGraph<W>::LoadGraphFromDimacs(const std::string& filename) {
+  MappedFile file(filename);
+  const char* const data = file.Data();
+  const char* const end = data + file.Size();
+
+  BasicGraph graph(BuildCsr<W>([data, end](auto&& add_arc) {
+    std::size_t vertices = 0;
+    bool has_problem = false;
+    ForEachLine(data, end, "c", [&](const char* first, const char* last) {
+      if (*first == 'p' && !has_problem) {
+        first = parser::SkipSpaces(first + 1, last);
+        if (last - first < 2 || std::strncmp(first, "sp", 2) != 0) {
+          throw std::runtime_error("Invalid graph file");
+        }
+        std::size_t arcs;
+        first = parser::ParseNumber(first + 2, last, &vertices);
+        parser::ParseNumber(first, last, &arcs);
+        has_problem = true;
+      } else if (*first == 'a' && has_problem) {
+        std::size_t from, to;
+        W weight;
+        ParseArc(first + 1, last, &from, &to, &weight);
+        if (from > vertices || to > vertices) {
+          throw std::runtime_error("Invalid graph file");
+        }
+        if (weight != kNoEdge) add_arc(from - 1, to - 1, weight);
+      } else {
+        throw std::runtime_error("Invalid graph file");
+      }
+    });
+    return vertices;
+  }));
+  graph.StartNewLog(version_ + 1);
+  Swap(&graph);
+}
+
+#define S21_INSTANTIATE_EDGE_LIST(W)                                        \
+  template void BasicGraph<W>::LoadGraphFromEdgeList(const std::string&,    \
+                                                     bool);                 \
+  template void BasicGraph<W>::LoadGraphFromDimacs(const std::string&);
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_EDGE_LIST)
+
+#undef S21_INSTANTIATE_EDGE_LIST
+
+}  // namespace s21
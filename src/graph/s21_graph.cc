@@ -1,84 +1,419 @@
 #include "s21_graph.h"
 
+#include <algorithm>
+
+#include <charconv>
+#include <cstring>
+
+#include "s21_mapped_file.h"
+#include "s21_parallel.h"
+#include "s21_text_parser.h"
+
 namespace s21 {
 
-Graph::Graph() : adj_matrix_(std::make_shared<Matrix>()) {}
+namespace {
 
-Graph::Graph(std::size_t vertices)
-    : adj_matrix_(std::make_shared<Matrix>(vertices, vertices)) {}
+// Rows are handed to the DOT export workers in blocks of about this many
+// arcs.
+constexpr std::size_t kDotBlockArcs = 1 << 16;
 
-Graph::Graph(const Graph& other) : adj_matrix_(other.adj_matrix_) {}
+char* AppendText(char* out, const char* text) {
+  std::size_t const size = std::strlen(text);
+  std::memcpy(out, text, size);
+  return out + size;
+}
+
+// Appends "\tv<from> -> v<to> [weight=<weight>];\n" (or "--" when
+// undirected) with vertices numbered from 1.
+template <typename W>
+void AppendDotEdge(std::size_t from, std::size_t to, W weight, bool directed,
+                   std::string* buffer) {
+  // Two 20 digit ids, a shortest round-trip double and the punctuation.
+  char line[128];
+  char* const end = line + sizeof(line);
+  char* out = AppendText(line, "\tv");
+  out = std::to_chars(out, end, from + 1).ptr;
+  out = AppendText(out, directed ? " -> v" : " -- v");
+  out = std::to_chars(out, end, to + 1).ptr;
+  out = AppendText(out, " [weight=");
+  out = std::to_chars(out, end, weight).ptr;
+  out = AppendText(out, "];\n");
+  buffer->append(line, out);
+}
 
-Graph::Graph(Graph&& other) { Swap(&other); }
+}  // namespace
+
+template <typename W>
+BasicGraph<W>::BasicGraph() : adj_matrix_(std::make_shared<matrix_type>()) {}
+
+template <typename W>
+BasicGraph<W>::BasicGraph(std::size_t vertices)
+    : adj_matrix_(std::make_shared<matrix_type>(vertices, vertices)) {}
+
+template <typename W>
+BasicGraph<W>::BasicGraph(csr_type adjacency)
+    : adj_list_(std::make_shared<csr_type>(std::move(adjacency))) {
+  if (adj_list_->GetRows() != adj_list_->GetColumns()) {
+    throw std::invalid_argument("Graph: adjacency matrix must be square");
+  }
+}
 
-Graph& Graph::operator=(const Graph& other) {
+template <typename W>
+BasicGraph<W>::BasicGraph(const BasicGraph& other)
+    : adj_matrix_(other.adj_matrix_),
+      adj_list_(other.adj_list_),
+      adj_tri_(other.adj_tri_),
+      order_(other.order_),
+      cache_(std::atomic_load(&other.cache_)),
+      version_(other.version_),
+      log_begin_(other.log_begin_),
+      changes_(other.changes_) {}
+
+// The source is left an empty graph, not one without storage.
+template <typename W>
+BasicGraph<W>::BasicGraph(BasicGraph&& other) : BasicGraph() {
+  Swap(&other);
+}
+
+template <typename W>
+BasicGraph<W>& BasicGraph<W>::operator=(const BasicGraph& other) {
   if (this != &other) {
-    Graph(other).Swap(this);
+    // The graph is replaced as a whole: keep the version increasing.
+    std::uint64_t const version = std::max(version_, other.version_) + 1;
+    BasicGraph(other).Swap(this);
+    StartNewLog(version);
   }
   return *this;
 }
 
-Graph& Graph::operator=(Graph&& other) {
+template <typename W>
+BasicGraph<W>& BasicGraph<W>::operator=(BasicGraph&& other) {
   if (this != &other) {
-    Graph(other).Swap(this);
+    std::uint64_t const version = std::max(version_, other.version_) + 1;
+    BasicGraph(std::move(other)).Swap(this);
+    StartNewLog(version);
   }
   return *this;
 }
 
-int& Graph::operator()(std::size_t i, std::size_t j) {
-  return const_cast<int&>(const_cast<const Graph*>(this)->operator()(i, j));
+template <typename W>
+typename BasicGraph<W>::WeightReference BasicGraph<W>::operator()(
+    std::size_t i, std::size_t j) {
+  CheckVertices(i, j);
+  return WeightReference(this, ToStorageId(i), ToStorageId(j));
 }
 
-const int& Graph::operator()(std::size_t i, std::size_t j) const {
-  return adj_matrix_->operator()(i, j);
+template <typename W>
+const W& BasicGraph<W>::operator()(std::size_t i, std::size_t j) const {
+  return StorageCell(ToStorageId(i), ToStorageId(j));
 }
 
-void Graph::Swap(Graph* other) { std::swap(adj_matrix_, other->adj_matrix_); }
+template <typename W>
+void BasicGraph<W>::Swap(BasicGraph* other) {
+  std::swap(adj_matrix_, other->adj_matrix_);
+  std::swap(adj_list_, other->adj_list_);
+  std::swap(adj_tri_, other->adj_tri_);
+  std::swap(order_, other->order_);
+  std::swap(cache_, other->cache_);
+  std::swap(version_, other->version_);
+  std::swap(log_begin_, other->log_begin_);
+  std::swap(changes_, other->changes_);
+}
 
-std::size_t Graph::AmountOfVertices() const { return adj_matrix_->GetRows(); }
+template <typename W>
+std::size_t BasicGraph<W>::AmountOfVertices() const {
+  if (adj_list_ != nullptr) return adj_list_->GetRows();
+  if (adj_tri_ != nullptr) return adj_tri_->GetSize();
+  return adj_matrix_->GetRows();
+}
 
-void Graph::LoadGraphFromFile(const std::string& filename) {
-  std::ifstream infile(filename);
-  if (infile.is_open() == false) {
-    throw std::runtime_error("Could not open file");
+template <typename W>
+void BasicGraph<W>::AddEdge(std::size_t from, std::size_t to, W weight) {
+  CheckVertices(from, to);
+  if (weight == kNoEdge) {
+    throw std::invalid_argument("AddEdge: weight must not be zero");
+  }
+  if (static_cast<const BasicGraph&>(*this)(from, to) != kNoEdge) {
+    throw std::logic_error("AddEdge: the edge already exists");
+  }
+  WriteEdge(ToStorageId(from), ToStorageId(to), weight);
+  Record(from, to, kNoEdge, weight);
+}
+
+template <typename W>
+void BasicGraph<W>::RemoveEdge(std::size_t from, std::size_t to) {
+  CheckVertices(from, to);
+  W const old_weight = static_cast<const BasicGraph&>(*this)(from, to);
+  if (old_weight == kNoEdge) {
+    throw std::logic_error("RemoveEdge: there is no such edge");
+  }
+  WriteEdge(ToStorageId(from), ToStorageId(to), kNoEdge);
+  Record(from, to, old_weight, kNoEdge);
+}
+
+template <typename W>
+void BasicGraph<W>::SetWeight(std::size_t from, std::size_t to, W weight) {
+  CheckVertices(from, to);
+  if (weight == kNoEdge) {
+    throw std::invalid_argument("SetWeight: weight must not be zero");
+  }
+  W const old_weight = static_cast<const BasicGraph&>(*this)(from, to);
+  if (old_weight == kNoEdge) {
+    throw std::logic_error("SetWeight: there is no such edge");
+  }
+  WriteEdge(ToStorageId(from), ToStorageId(to), weight);
+  Record(from, to, old_weight, weight);
+}
+
+template <typename W>
+std::uint64_t BasicGraph<W>::Version() const {
+  return version_;
+}
+
+template <typename W>
+std::vector<typename BasicGraph<W>::EdgeChange> BasicGraph<W>::ChangesSince(
+    std::uint64_t version) const {
+  if (version < log_begin_ || version > version_) {
+    throw std::out_of_range("ChangesSince: version is not in the change log");
+  }
+  return std::vector<EdgeChange>(changes_.begin() + (version - log_begin_),
+                                 changes_.end());
+}
+
+template <typename W>
+void BasicGraph<W>::TrimChangeLog(std::uint64_t version) {
+  if (version <= log_begin_) return;
+  version = std::min(version, version_);
+  changes_.erase(changes_.begin(),
+                 changes_.begin() + (version - log_begin_));
+  log_begin_ = version;
+}
+
+template <typename W>
+bool BasicGraph<W>::IsSparse() const { return adj_list_ != nullptr; }
+
+template <typename W>
+bool BasicGraph<W>::IsTriangular() const {
+  return adj_tri_ != nullptr;
+}
+
+template <typename W>
+void BasicGraph<W>::ToSparse() {
+  if (adj_list_ == nullptr) {
+    adj_list_ = std::make_shared<csr_type>(
+        adj_tri_ != nullptr ? adj_tri_->ToMatrix() : *adj_matrix_);
+    adj_matrix_.reset();
+    adj_tri_.reset();
+  }
+}
+
+template <typename W>
+void BasicGraph<W>::ToDense() {
+  if (adj_matrix_ == nullptr) {
+    adj_matrix_ = std::make_shared<matrix_type>(
+        adj_list_ != nullptr ? adj_list_->ToMatrix() : adj_tri_->ToMatrix());
+    adj_list_.reset();
+    adj_tri_.reset();
+  }
+}
+
+template <typename W>
+void BasicGraph<W>::ToTriangular() {
+  if (adj_tri_ != nullptr) return;
+  if (IsDirected()) {
+    throw std::logic_error("ToTriangular: the graph is directed");
   }
+  adj_tri_ = std::make_shared<triangular_type>(
+      adj_list_ != nullptr ? adj_list_->ToMatrix() : *adj_matrix_);
+  adj_matrix_.reset();
+  adj_list_.reset();
+}
+
+template <typename W>
+BitMatrix BasicGraph<W>::ToBitMatrix() const {
+  BitMatrix bits(AmountOfVertices(), AmountOfVertices());
+  for (std::size_t i = 0; i < AmountOfVertices(); i++) {
+    BitMatrix::word_type* row = bits.Row(i);
+    ForEachNeighbor(ToStorageId(i), [this, row](std::size_t j, W) {
+      j = ToOriginalId(j);
+      row[j / BitMatrix::kWordBits] |= BitMatrix::word_type(1)
+                                       << (j % BitMatrix::kWordBits);
+    });
+  }
+  return bits;
+}
+
+template <typename W>
+void BasicGraph<W>::LoadGraphFromFile(const std::string& filename) {
+  MappedFile file(filename);
+  const char* first = file.Data();
+  const char* last = first + file.Size();
   std::size_t amount_of_vertices;
-  infile >> amount_of_vertices;
-  adj_matrix_ =
-      std::make_shared<Matrix>(amount_of_vertices, amount_of_vertices);
-  for (std::size_t i = 0; i < amount_of_vertices; i++) {
-    for (std::size_t j = 0; j < amount_of_vertices; j++) {
-      infile >> adj_matrix_->operator()(i, j);
-    }
+  first = parser::ParseNumber(first, last, &amount_of_vertices);
+  // Undirected graphs are parsed straight into the packed triangle; the
+  // dense matrix is only allocated once the file turns out to be
+  // asymmetric, and then takes over the upper half already parsed.
+  auto triangle = std::make_shared<triangular_type>(amount_of_vertices);
+  auto matrix = std::make_shared<matrix_type>();
+  if (parser::ParseSymmetricMatrix(first, last, triangle.get(),
+                                   matrix.get())) {
+    matrix.reset();
+  } else {
+    triangle.reset();
   }
-  infile.close();
+  adj_matrix_ = std::move(matrix);
+  adj_list_.reset();
+  adj_tri_ = std::move(triangle);
+  order_.reset();
+  std::atomic_store(&cache_, std::shared_ptr<Cache>());
+  AssumeDirected(adj_tri_ == nullptr);
+  StartNewLog(version_ + 1);
 }
 
-void Graph::ExportGraphToDot(const std::string& filename) {
-  std::ofstream outfile(filename);
+template <typename W>
+void BasicGraph<W>::ExportGraphToDot(const std::string& filename,
+                                     unsigned threads) const {
+  std::ofstream outfile(filename, std::ios::binary);
   if (outfile.is_open() == false) {
     throw std::runtime_error("Could not open file");
   }
-  std::string edge_type = " -- ";
-  for (size_t i = 0; i < AmountOfVertices(); i++) {
-    for (size_t j = i; j < AmountOfVertices(); j++) {
-      if (adj_matrix_->operator()(i, j) != adj_matrix_->operator()(j, i)) {
-        edge_type = " -> ";
-        break;
+  bool const directed = IsDirected();
+  auto const adjacency = Csr();
+  std::size_t const vertices = AmountOfVertices();
+  threads = ResolveThreads(threads);
+
+  // Every round cuts the next rows into up to threads blocks of about
+  // kDotBlockArcs arcs, formats each block into its own buffer in parallel
+  // and then writes the buffers in order.
+  std::vector<std::string> buffers(threads);
+  std::vector<std::size_t> bounds(threads + 1);
+  outfile << (directed ? "digraph" : "graph") << " graphname {\n";
+  for (std::size_t row = 0; row < vertices;) {
+    unsigned blocks = 0;
+    bounds[0] = row;
+    while (blocks < threads && row < vertices) {
+      for (std::size_t arcs = 0; arcs < kDotBlockArcs && row < vertices;) {
+        std::size_t const i = ToStorageId(row++);
+        arcs += adjacency->RowEnd(i) - adjacency->RowBegin(i) + 1;
       }
+      bounds[++blocks] = row;
     }
-  }
-  outfile << "graph graphname {\n";
-  for (size_t i = 0; i < AmountOfVertices(); i++) {
-    size_t j = (edge_type == " -- ") ? i : 0;
-    for (; j < AmountOfVertices(); j++) {
-      if (adj_matrix_->operator()(i, j) != 0) {
-        outfile << "\tv" << i + 1 << edge_type << "v" << j + 1 << ";\n";
+    RunParallel(blocks, [&](unsigned t) {
+      std::string& buffer = buffers[t];
+      buffer.clear();
+      for (std::size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+        adjacency->ForEachInRow(ToStorageId(i), [&](std::size_t j, W weight) {
+          j = ToOriginalId(j);
+          if (directed || j >= i) {
+            AppendDotEdge(i, j, weight, directed, &buffer);
+          }
+        });
       }
+    });
+    for (unsigned t = 0; t < blocks; t++) {
+      outfile.write(buffers[t].data(),
+                    static_cast<std::streamsize>(buffers[t].size()));
     }
   }
   outfile << "}\n";
   outfile.close();
+  if (!outfile) {
+    throw std::runtime_error("Could not write file");
+  }
+}
+
+template <typename W>
+void BasicGraph<W>::CheckVertices(std::size_t from, std::size_t to) const {
+  if (from >= AmountOfVertices() || to >= AmountOfVertices()) {
+    throw std::out_of_range("from or to is out of range");
+  }
 }
 
+template <typename W>
+const W& BasicGraph<W>::StorageCell(std::size_t i, std::size_t j) const {
+  if (adj_list_ != nullptr) {
+    const W* weight = adj_list_->Find(i, j);
+    return weight == nullptr ? kNoEdge : *weight;
+  }
+  if (adj_tri_ != nullptr) return adj_tri_->operator()(i, j);
+  return adj_matrix_->operator()(i, j);
+}
+
+template <typename W>
+void BasicGraph<W>::WriteCell(std::size_t i, std::size_t j, W weight) {
+  // The packed cell is both arcs: only a write that keeps them equal can
+  // stay in it.
+  if (adj_tri_ != nullptr && i != j && weight != (*adj_tri_)(i, j)) {
+    ToDense();
+  }
+  WriteEdge(i, j, weight);
+}
+
+template <typename W>
+void BasicGraph<W>::AssignCell(std::size_t i, std::size_t j, W weight) {
+  W const old_weight = StorageCell(i, j);
+  if (weight == old_weight) return;
+  // A differing write leaves no triangular storage, so one arc is logged.
+  WriteCell(i, j, weight);
+  Record(ToOriginalId(i), ToOriginalId(j), old_weight, weight);
+}
+
+template <typename W>
+void BasicGraph<W>::WriteEdge(std::size_t i, std::size_t j, W weight) {
+  Detach();
+  if (adj_tri_ != nullptr) {
+    adj_tri_->operator()(i, j) = weight;
+    return;
+  }
+  if (adj_list_ == nullptr) {
+    adj_matrix_->operator()(i, j) = weight;
+    return;
+  }
+  W* cell = adj_list_->Find(i, j);
+  if (cell != nullptr && weight != kNoEdge) {
+    *cell = weight;
+  } else if (cell != nullptr) {
+    adj_list_->Erase(i, j);
+  } else if (weight != kNoEdge) {
+    adj_list_->Insert(i, j, weight);
+  }
+}
+
+template <typename W>
+void BasicGraph<W>::Detach() {
+  // Whatever is about to be written, the derived structures are stale.
+  std::atomic_store(&cache_, std::shared_ptr<Cache>());
+  if (adj_tri_ != nullptr) {
+    if (adj_tri_.use_count() > 1) {
+      adj_tri_ = std::make_shared<triangular_type>(*adj_tri_);
+    }
+  } else if (adj_list_ != nullptr) {
+    if (adj_list_.use_count() > 1) {
+      adj_list_ = std::make_shared<csr_type>(*adj_list_);
+    }
+  } else if (adj_matrix_.use_count() > 1) {
+    adj_matrix_ = std::make_shared<matrix_type>(*adj_matrix_);
+  }
+}
+
+template <typename W>
+void BasicGraph<W>::Record(std::size_t from, std::size_t to, W old_weight,
+                           W new_weight) {
+  version_++;
+  changes_.push_back({version_, from, to, old_weight, new_weight});
+  if (adj_tri_ != nullptr && from != to) {
+    version_++;
+    changes_.push_back({version_, to, from, old_weight, new_weight});
+  }
+}
+
+template <typename W>
+void BasicGraph<W>::StartNewLog(std::uint64_t version) {
+  version_ = version;
+  log_begin_ = version;
+  changes_.clear();
+}
+
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicGraph)
+
 }  // namespace s21
@@ -1,38 +1,315 @@
 #ifndef SRC_GRAPH_S21_GRAPH_H_
 #define SRC_GRAPH_S21_GRAPH_H_
 
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
+#include "../matrix/s21_bit_matrix.h"
+#include "../matrix/s21_csr_matrix.h"
 #include "../matrix/s21_matrix_oop.h"
+#include "../matrix/s21_triangular_matrix.h"
 
 namespace s21 {
 
-class Graph {
+// Vertex orders for BasicGraph::Reorder.
+enum class VertexOrder {
+  kOriginal,              // the numbering of the loaded file
+  kReverseCuthillMcKee,   // small bandwidth: neighbours get close ids
+  kBreadthFirst,          // breadth-first discovery order
+  kDegree                 // by decreasing degree, hubs first
+};
+
+// Graph with edge weights of type W, zero meaning "no edge"; Graph is the
+// int one.
+//
+// The adjacency is stored in one of three ways: a dense matrix, a CSR
+// matrix (ToSparse) or, for undirected graphs, the packed upper triangle
+// of the matrix (ToTriangular), which LoadGraphFromFile picks by itself
+// when the matrix is symmetric. All of them read the same way. The
+// triangular storage is written in place: the tracked mutations there
+// change an edge, that is both of its arcs, and only a write through
+// operator() that sets one arc apart from the other expands it to the
+// dense storage.
+//
+// Reorder relabels the vertices inside the storage for cache locality.
+// Every public method still takes and returns the original vertex ids,
+// except ForEachNeighbor, which walks the storage and so works with
+// storage ids; ToStorageId and ToOriginalId translate between the two.
+//
+// Copies share the adjacency storage until one of them is written to,
+// which then copies it first (copy on write), so a copy is a cheap and
+// immutable snapshot of the graph. The non-const operator() returns a
+// WeightReference, which only does that when it is assigned to; unlike a
+// W& it cannot be bound to a W& or have its address taken.
+template <typename W>
+class BasicGraph {
  public:
-  Graph();
-  explicit Graph(std::size_t vertices);
-  Graph(const Graph& other);
-  Graph(Graph&& other);
-  ~Graph() = default;
+  using weight_type = W;
+  // Lengths of paths: integer weights are summed in 64 bits, so that a
+  // long path of e.g. std::int16_t arcs does not overflow.
+  using distance_type =
+      std::conditional_t<std::is_integral_v<W>, std::int64_t, W>;
+  using matrix_type = BasicMatrix<W>;
+  using csr_type = BasicCsrMatrix<W>;
+  using triangular_type = BasicTriangularMatrix<W>;
+
+  // One applied mutation: the arc from -> to went from old_weight to
+  // new_weight (kNoEdge when it was added or removed), producing version.
+  struct EdgeChange {
+    std::uint64_t version;
+    std::size_t from, to;
+    W old_weight, new_weight;
+  };
+
+  // A cell of the adjacency matrix. Reading it leaves the storage as it
+  // is; assigning to it makes the storage writable first, and on the
+  // sparse storage assigning kNoEdge removes the arc and assigning to an
+  // absent arc adds it, in O(E). Assignments that change the weight are
+  // tracked mutations of the single arc.
+  class WeightReference {
+   public:
+    operator W() const {
+      return static_cast<const BasicGraph*>(graph_)->StorageCell(i_, j_);
+    }
+    WeightReference& operator=(W weight) {
+      graph_->AssignCell(i_, j_, weight);
+      return *this;
+    }
+    WeightReference& operator=(const WeightReference& other) {
+      return *this = static_cast<W>(other);
+    }
+    WeightReference& operator+=(W weight) {
+      return *this = static_cast<W>(static_cast<W>(*this) + weight);
+    }
+    WeightReference& operator-=(W weight) {
+      return *this = static_cast<W>(static_cast<W>(*this) - weight);
+    }
+    WeightReference& operator*=(W weight) {
+      return *this = static_cast<W>(static_cast<W>(*this) * weight);
+    }
+    WeightReference& operator/=(W weight) {
+      return *this = static_cast<W>(static_cast<W>(*this) / weight);
+    }
+
+   private:
+    friend class BasicGraph;
+
+    WeightReference(BasicGraph* graph, std::size_t i, std::size_t j)
+        : graph_(graph), i_(i), j_(j) {}
+    WeightReference(const WeightReference& other) = default;
 
-  Graph& operator=(const Graph& other);
-  Graph& operator=(Graph&& other);
-  int& operator()(std::size_t i, std::size_t j);
-  const int& operator()(std::size_t i, std::size_t j) const;
+    BasicGraph* graph_;
+    std::size_t i_, j_;
+  };
 
-  void Swap(Graph* other);
+  BasicGraph();
+  explicit BasicGraph(std::size_t vertices);
+  explicit BasicGraph(csr_type adjacency);
+  BasicGraph(const BasicGraph& other);
+  BasicGraph(BasicGraph&& other);
+  ~BasicGraph() = default;
+
+  BasicGraph& operator=(const BasicGraph& other);
+  BasicGraph& operator=(BasicGraph&& other);
+  WeightReference operator()(std::size_t i, std::size_t j);
+  const W& operator()(std::size_t i, std::size_t j) const;
+
+  void Swap(BasicGraph* other);
 
   std::size_t AmountOfVertices() const;
 
+  // Permutes the storage into the given order (computed on the outgoing
+  // arcs). The permutation is kept, so operator(), the mutation API and
+  // the exports keep using the original ids.
+  void Reorder(VertexOrder order);
+  bool IsReordered() const;
+  std::size_t ToStorageId(std::size_t vertex) const;
+  std::size_t ToOriginalId(std::size_t vertex) const;
+
+  // Mutations that are tracked: each one bumps Version() by one and is
+  // recorded in the change log. AddEdge requires the arc to be absent,
+  // RemoveEdge and SetWeight require it to be present, weights must not be
+  // zero. A write through operator() that changes a weight is logged as
+  // one of them; loading a file is not logged and starts a new log at a
+  // new version. On the sparse storage adding
+  // or removing an arc costs O(E). On the triangular storage they apply to
+  // both arcs from -> to and to -> from, which are logged one after the
+  // other (a loop only once); call ToDense first to change a single arc.
+  void AddEdge(std::size_t from, std::size_t to, W weight);
+  void RemoveEdge(std::size_t from, std::size_t to);
+  void SetWeight(std::size_t from, std::size_t to, W weight);
+
+  std::uint64_t Version() const;
+  // The changes made after the given version, oldest first. Throws
+  // std::out_of_range if the log no longer reaches back that far (after
+  // a load or TrimChangeLog); the caller then has to start from scratch.
+  std::vector<EdgeChange> ChangesSince(std::uint64_t version) const;
+  // Forget the changes up to and including the given version.
+  void TrimChangeLog(std::uint64_t version);
+
+  bool IsSparse() const;
+  bool IsTriangular() const;
+  void ToSparse();
+  void ToDense();
+  // Throws std::logic_error if the graph is not undirected.
+  void ToTriangular();
+  // Unweighted copy of the adjacency, one bit per vertex pair, for the
+  // reachability searches that only ask whether an edge exists.
+  BitMatrix ToBitMatrix() const;
+
+  // Derived structures, built on first use and kept until the storage is
+  // written to (which includes assigning through operator()), reordered
+  // or reloaded. Copies share them as they share the storage. They may be
+  // requested from several threads at once and all use storage ids.
+  struct SortedNeighbors {
+    // The arcs leaving vertex v are [offsets[v], offsets[v + 1]), by
+    // increasing weight and then by target.
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> targets;
+    std::vector<W> weights;
+  };
+  // The adjacency as a CSR matrix; the storage itself when it is sparse.
+  std::shared_ptr<const csr_type> Csr() const;
+  // Row v lists the arcs entering v.
+  std::shared_ptr<const csr_type> ReverseCsr() const;
+  std::shared_ptr<const std::vector<std::size_t>> OutDegrees() const;
+  std::shared_ptr<const SortedNeighbors> NeighborsByWeight() const;
+  // The arc positions of every row of Csr(), which is sorted by storage
+  // id, permuted to increasing original id of the target: row v is
+  // visited in original order as Csr()[arcs[k]] for k in its range.
+  std::shared_ptr<const std::vector<std::size_t>> ArcsByOriginalId() const;
+  bool IsDirected() const;
+  // The smallest and the largest weight, kNoEdge if there are no edges.
+  W MinWeight() const;
+  W MaxWeight() const;
+  // True if there is at least one edge and all edges weigh the same.
+  bool HasUniformWeights() const;
+  // A hash of the arcs and their weights by original id and of
+  // IsDirected: equal for graphs of equal content, whatever their storage,
+  // order or version, e.g. a copy or the same file loaded again.
+  std::uint64_t Fingerprint() const;
+
+  // Calls function(to, weight) for every edge leaving the vertex, in
+  // ascending order of the target vertex; both are storage ids. Costs
+  // O(degree) for the sparse storage and O(V) for the dense ones.
+  template <typename Function>
+  void ForEachNeighbor(std::size_t vertex, Function&& function) const;
+
   void LoadGraphFromFile(const std::string& filename);
-  void ExportGraphToDot(const std::string& filename);
+  // Writes a "graph" with "--" edges if the graph is undirected and a
+  // "digraph" with "->" arcs otherwise, the weights as edge attributes.
+  // The text is formatted by up to threads workers, 0 meaning the
+  // hardware concurrency.
+  void ExportGraphToDot(const std::string& filename,
+                        unsigned threads = 0) const;
+
+  // Edge lists hold one "from to weight" arc per line with vertices
+  // numbered from 1, lines starting with '#' or '%' are comments. DIMACS is
+  // the ".gr" shortest path format ("p sp n m", "a from to weight"). Both
+  // are streamed straight into the sparse storage, never building the
+  // matrix; duplicate arcs keep the least weight.
+  void LoadGraphFromEdgeList(const std::string& filename,
+                             bool undirected = false);
+  void LoadGraphFromDimacs(const std::string& filename);
+
+  // Versioned binary format (see s21_graph_binary.h). The loaded file is
+  // mapped into memory and used as the storage as is, without parsing.
+  // The sizes and the CSR offsets and columns are always checked, in one
+  // pass over the sparse sections. The stored direction is trusted unless
+  // verify, which checks it against the arcs: an asymmetric file marked
+  // undirected otherwise gives wrong components, bidirectional searches
+  // and DOT output, so verify files that do not come from
+  // ExportGraphToBinary.
+  void LoadGraphFromBinary(const std::string& filename, bool verify = false);
+  void ExportGraphToBinary(const std::string& filename) const;
 
  private:
-  std::shared_ptr<Matrix> adj_matrix_;
+  static constexpr W kNoEdge = 0;
+
+  struct Cache;
+
+  struct Permutation {
+    std::vector<std::size_t> to_original, to_storage;
+  };
+
+  // The weight of the arc i -> j in storage ids.
+  const W& StorageCell(std::size_t i, std::size_t j) const;
+  // Writes the arc i -> j alone, expanding the triangular storage first
+  // if the write would make it asymmetric.
+  void WriteCell(std::size_t i, std::size_t j, W weight);
+  // WriteCell for operator(): logs the write if it changes the weight.
+  void AssignCell(std::size_t i, std::size_t j, W weight);
+  // Detaches and writes the cell, on the triangular storage the arcs
+  // i -> j and j -> i together; the sparse storage keeps only the arcs, so
+  // there kNoEdge erases the cell and any other weight inserts it.
+  void WriteEdge(std::size_t i, std::size_t j, W weight);
+  void Permute(std::vector<std::size_t> to_original);
+  std::shared_ptr<Cache> GetCache() const;
+  // Tells the cache what IsDirected would find, e.g. from a file header.
+  void AssumeDirected(bool directed) const;
+  void ComputeWeightStats(Cache* cache) const;
+  void CheckVertices(std::size_t from, std::size_t to) const;
+  // Makes the storage exclusive to this graph before a write: shared
+  // storage is copied.
+  void Detach();
+  // Logs a tracked mutation, on the triangular storage for both arcs.
+  void Record(std::size_t from, std::size_t to, W old_weight, W new_weight);
+  void StartNewLog(std::uint64_t version);
+
+  std::shared_ptr<matrix_type> adj_matrix_;
+  std::shared_ptr<csr_type> adj_list_;
+  std::shared_ptr<triangular_type> adj_tri_;
+  // Null while the storage is in the original order.
+  std::shared_ptr<const Permutation> order_;
+  // Created on first use; written with atomic operations only, since
+  // const methods may run concurrently.
+  mutable std::shared_ptr<Cache> cache_;
+
+  // changes_[k] produced version log_begin_ + k + 1.
+  std::uint64_t version_ = 0;
+  std::uint64_t log_begin_ = 0;
+  std::vector<EdgeChange> changes_;
 };
 
+using Graph = BasicGraph<int>;
+
+S21_DECLARE_FOR_CELL_TYPES(BasicGraph)
+
+template <typename W>
+template <typename Function>
+void BasicGraph<W>::ForEachNeighbor(std::size_t vertex,
+                                    Function&& function) const {
+  if (adj_list_ != nullptr) {
+    adj_list_->ForEachInRow(vertex, function);
+  } else if (adj_tri_ != nullptr) {
+    std::size_t const size = adj_tri_->GetSize();
+    if (vertex >= size) {
+      throw std::out_of_range("ForEachNeighbor: vertex is out of range");
+    }
+    // (j, vertex) for j < vertex is stored in the rows above.
+    for (std::size_t j = 0; j < vertex; j++) {
+      W const weight = adj_tri_->RowTail(j)[vertex - j];
+      if (weight != kNoEdge) function(j, weight);
+    }
+    const W* tail = adj_tri_->RowTail(vertex);
+    for (std::size_t j = vertex; j < size; j++) {
+      if (tail[j - vertex] != kNoEdge) function(j, tail[j - vertex]);
+    }
+  } else {
+    if (vertex >= adj_matrix_->GetRows()) {
+      throw std::out_of_range("ForEachNeighbor: vertex is out of range");
+    }
+    const W* row = adj_matrix_->Row(vertex);
+    for (std::size_t j = 0; j < adj_matrix_->GetColumns(); j++) {
+      if (row[j] != kNoEdge) function(j, row[j]);
+    }
+  }
+}
+
 }  // namespace s21
 
 #endif  // SRC_GRAPH_S21_GRAPH_H_
@@ -0,0 +1,203 @@
+#include "s21_graph_binary.h"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "s21_graph.h"
+#include "s21_mapped_file.h"
+
+namespace s21 {
+
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t),
+              "CSR offsets are stored as uint64");
+static_assert(std::is_same_v<int, std::int32_t>,
+              "int weights are stored as int32");
+
+template <typename W>
+void BasicGraph<W>::LoadGraphFromBinary(const std::string& filename,
+                                        bool verify) {
+  auto file = std::make_shared<MappedFile>(filename);
+  binary::Header header;
+  if (file->Size() < sizeof(header)) {
+    throw std::runtime_error("Invalid binary graph file");
+  }
+  std::memcpy(&header, file->Data(), sizeof(header));
+  if (std::memcmp(header.magic, binary::kMagic, sizeof(header.magic)) != 0 ||
+      header.version != binary::kVersion ||
+      header.weight_type != binary::WeightTypeOf<W>()) {
+    throw std::runtime_error("Unsupported binary graph file");
+  }
+  if (header.directed > 1 ||
+      (header.directed == 1 && header.layout == binary::Layout::kTriangular)) {
+    throw std::runtime_error("Invalid binary graph file");
+  }
+
+  std::size_t const size = file->Size();
+  if (header.vertices > size || header.stride > size) {
+    throw std::runtime_error("Invalid binary graph file");
+  }
+  auto const section_fits = [size](std::uint64_t offset, std::uint64_t count,
+                                   std::uint64_t item_size) {
+    return offset <= size && count <= (size - offset) / item_size;
+  };
+  std::size_t const vertices = header.vertices;
+  std::uint64_t const offset = binary::AlignSection(sizeof(header));
+  char* data = file->Data();
+
+  BasicGraph graph;
+  std::uint64_t end = offset;
+  if (header.layout == binary::Layout::kDense) {
+    if (header.stride < vertices ||
+        (vertices > 0 &&
+         !section_fits(offset, vertices, header.stride * sizeof(W)))) {
+      throw std::runtime_error("Invalid binary graph file");
+    }
+    if (vertices > 0) {
+      graph.adj_matrix_ = std::make_shared<matrix_type>(
+          vertices, vertices, header.stride,
+          reinterpret_cast<W*>(data + offset), file);
+    }
+    end = offset + vertices * header.stride * sizeof(W);
+  } else if (header.layout == binary::Layout::kTriangular) {
+    // Below 2^32 vertices the packed cell count cannot overflow; no file
+    // holds that many cells anyway.
+    if (vertices > UINT32_MAX ||
+        !section_fits(offset, triangular_type::PackedSize(vertices),
+                      sizeof(W))) {
+      throw std::runtime_error("Invalid binary graph file");
+    }
+    if (vertices > 0) {
+      graph.adj_matrix_.reset();
+      graph.adj_tri_ = std::make_shared<triangular_type>(
+          vertices, reinterpret_cast<W*>(data + offset), file);
+    }
+    end = offset + triangular_type::PackedSize(vertices) * sizeof(W);
+  } else if (header.layout == binary::Layout::kSparse) {
+    using index_type = typename csr_type::index_type;
+    std::uint64_t const non_zeros = header.non_zeros;
+    std::uint64_t const columns_offset =
+        binary::AlignSection(offset + (vertices + 1) * sizeof(std::size_t));
+    std::uint64_t const values_offset =
+        binary::AlignSection(columns_offset + non_zeros * sizeof(index_type));
+    if (!section_fits(offset, vertices + 1, sizeof(std::size_t)) ||
+        !section_fits(columns_offset, non_zeros, sizeof(index_type)) ||
+        !section_fits(values_offset, non_zeros, sizeof(W))) {
+      throw std::runtime_error("Invalid binary graph file");
+    }
+    auto const offsets = reinterpret_cast<const std::size_t*>(data + offset);
+    if (offsets[vertices] != non_zeros) {
+      throw std::runtime_error("Invalid binary graph file");
+    }
+    try {
+      graph = BasicGraph(csr_type(
+          vertices, vertices, offsets,
+          reinterpret_cast<const index_type*>(data + columns_offset),
+          reinterpret_cast<W*>(data + values_offset), file));
+    } catch (const std::invalid_argument&) {
+      throw std::runtime_error("Invalid binary graph file");
+    }
+    end = values_offset + non_zeros * sizeof(W);
+  } else {
+    throw std::runtime_error("Unsupported binary graph file");
+  }
+  if (header.permuted != 0) {
+    std::uint64_t const order_offset = binary::AlignSection(end);
+    if (!section_fits(order_offset, vertices, sizeof(std::uint64_t))) {
+      throw std::runtime_error("Invalid binary graph file");
+    }
+    auto const to_original =
+        reinterpret_cast<const std::uint64_t*>(data + order_offset);
+    auto permutation = std::make_shared<Permutation>();
+    permutation->to_original.assign(to_original, to_original + vertices);
+    permutation->to_storage.assign(vertices, vertices);
+    for (std::size_t k = 0; k < vertices; k++) {
+      std::size_t const original = permutation->to_original[k];
+      if (original >= vertices ||
+          permutation->to_storage[original] != vertices) {
+        throw std::runtime_error("Invalid binary graph file");
+      }
+      permutation->to_storage[original] = k;
+    }
+    graph.order_ = std::move(permutation);
+  }
+  bool const directed = header.directed != 0;
+  // Checking the direction reads every cell, so it is left to verify.
+  if (!verify) {
+    graph.AssumeDirected(directed);
+  } else if (graph.IsDirected() != directed) {
+    throw std::runtime_error("Invalid binary graph file");
+  }
+  graph.StartNewLog(version_ + 1);
+  Swap(&graph);
+}
+
+template <typename W>
+void BasicGraph<W>::ExportGraphToBinary(const std::string& filename) const {
+  std::ofstream outfile(filename, std::ios::binary);
+  if (outfile.is_open() == false) {
+    throw std::runtime_error("Could not open file");
+  }
+
+  binary::Header header = {};
+  std::memcpy(header.magic, binary::kMagic, sizeof(header.magic));
+  header.version = binary::kVersion;
+  header.vertices = AmountOfVertices();
+  header.weight_type = binary::WeightTypeOf<W>();
+  header.directed = IsDirected() ? 1 : 0;
+  header.permuted = order_ != nullptr ? 1 : 0;
+  if (adj_list_ != nullptr) {
+    header.layout = binary::Layout::kSparse;
+    header.non_zeros = adj_list_->GetNonZeros();
+  } else if (adj_tri_ != nullptr) {
+    header.layout = binary::Layout::kTriangular;
+  } else {
+    header.layout = binary::Layout::kDense;
+    header.stride = AmountOfVertices() > 0 ? adj_matrix_->GetStride() : 0;
+  }
+
+  std::uint64_t position = 0;
+  auto const write_section = [&outfile, &position](const void* section,
+                                                   std::uint64_t bytes) {
+    std::vector<char> const padding(binary::AlignSection(position) - position,
+                                    0);
+    outfile.write(padding.data(), (std::streamsize)padding.size());
+    outfile.write(static_cast<const char*>(section), (std::streamsize)bytes);
+    position = binary::AlignSection(position) + bytes;
+  };
+  write_section(&header, sizeof(header));
+  if (header.layout == binary::Layout::kSparse) {
+    std::size_t const no_rows = 0;
+    write_section(header.vertices > 0 ? adj_list_->Offsets() : &no_rows,
+                  (header.vertices + 1) * sizeof(std::size_t));
+    write_section(adj_list_->Columns(),
+                  header.non_zeros * sizeof(typename csr_type::index_type));
+    write_section(adj_list_->Values(), header.non_zeros * sizeof(W));
+  } else if (header.layout == binary::Layout::kTriangular) {
+    if (header.vertices > 0) {
+      write_section(adj_tri_->RowTail(0),
+                    triangular_type::PackedSize(header.vertices) * sizeof(W));
+    }
+  } else if (header.vertices > 0) {
+    write_section(adj_matrix_->Row(0),
+                  header.vertices * header.stride * sizeof(W));
+  }
+  if (order_ != nullptr) {
+    write_section(order_->to_original.data(),
+                  header.vertices * sizeof(std::uint64_t));
+  }
+  if (!outfile) {
+    throw std::runtime_error("Could not write file");
+  }
+}
+
+#define S21_INSTANTIATE_GRAPH_BINARY(W)                                   \
+  template void BasicGraph<W>::LoadGraphFromBinary(const std::string&,    \
+                                                   bool);                 \
+  template void BasicGraph<W>::ExportGraphToBinary(const std::string&) const;
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_GRAPH_BINARY)
+
+#undef S21_INSTANTIATE_GRAPH_BINARY
+
+}  // namespace s21
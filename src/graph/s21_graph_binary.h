@@ -0,0 +1,76 @@
+#ifndef SRC_GRAPH_S21_GRAPH_BINARY_H_
+#define SRC_GRAPH_S21_GRAPH_BINARY_H_
+
+#include <cstdint>
+
+namespace s21 {
+
+namespace binary {
+
+// On-disk layout of Graph::ExportGraphToBinary files (native byte order):
+// the header is followed by sections, each starting at a multiple of
+// kSectionAlignment bytes.
+//   kDense:  vertices rows of stride weight_type cells.
+//   kSparse: vertices + 1 uint64 offsets, non_zeros uint32 columns and
+//            non_zeros weight_type values of the CSR matrix.
+//   kTriangular: vertices * (vertices + 1) / 2 weight_type cells, the
+//            upper triangle of a symmetric matrix packed row by row.
+constexpr char kMagic[4] = {'S', '2', '1', 'G'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint64_t kSectionAlignment = 64;
+
+enum class WeightType : std::uint8_t {
+  kInt32 = 1,
+  kInt16 = 2,
+  kFloat32 = 3,
+  kFloat64 = 4
+};
+
+// The WeightType tag of the cells of BasicGraph<W>.
+template <typename W>
+constexpr WeightType WeightTypeOf();
+template <>
+constexpr WeightType WeightTypeOf<std::int16_t>() {
+  return WeightType::kInt16;
+}
+template <>
+constexpr WeightType WeightTypeOf<std::int32_t>() {
+  return WeightType::kInt32;
+}
+template <>
+constexpr WeightType WeightTypeOf<float>() {
+  return WeightType::kFloat32;
+}
+template <>
+constexpr WeightType WeightTypeOf<double>() {
+  return WeightType::kFloat64;
+}
+
+enum class Layout : std::uint8_t { kDense = 0, kSparse = 1, kTriangular = 2 };
+
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint64_t vertices;
+  std::uint64_t stride;
+  std::uint64_t non_zeros;
+  WeightType weight_type;
+  Layout layout;
+  std::uint8_t directed;
+  // Set when the storage is reordered (see BasicGraph::Reorder): one more
+  // section follows with the original id of every storage vertex, as
+  // vertices uint64 values.
+  std::uint8_t permuted;
+  std::uint8_t reserved[4];
+};
+
+inline std::uint64_t AlignSection(std::uint64_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+}  // namespace binary
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_S21_GRAPH_BINARY_H_
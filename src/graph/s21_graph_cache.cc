@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+namespace {
+
+// The splitmix64 finalizer: every input bit affects every output bit.
+std::uint64_t Mix(std::uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Double-checked publication of a built structure: readers that find it
+// built never touch the mutex.
+template <typename T, typename Build>
+std::shared_ptr<const T> LoadOrBuild(std::mutex* mutex,
+                                     std::shared_ptr<const T>* slot,
+                                     Build&& build) {
+  std::shared_ptr<const T> value = std::atomic_load(slot);
+  if (value != nullptr) return value;
+  std::lock_guard<std::mutex> lock(*mutex);
+  value = std::atomic_load(slot);
+  if (value == nullptr) {
+    value = build();
+    std::atomic_store(slot, value);
+  }
+  return value;
+}
+
+}  // namespace
+
+// Everything is built under the mutex the first time it is asked for and
+// then published with atomic operations, so later readers take no lock. The
+// results are immutable and handed out as shared pointers, so they stay
+// valid after the cache itself has been dropped.
+template <typename W>
+struct BasicGraph<W>::Cache {
+  std::mutex mutex;
+  std::shared_ptr<const csr_type> csr;
+  std::shared_ptr<const csr_type> reverse;
+  std::shared_ptr<const std::vector<std::size_t>> degrees;
+  std::shared_ptr<const SortedNeighbors> by_weight;
+  std::shared_ptr<const std::vector<std::size_t>> by_original_id;
+  enum class Tristate { kUnknown, kNo, kYes };
+  std::atomic<Tristate> symmetric{Tristate::kUnknown};
+  // Each flag is stored with release ordering after the values it guards.
+  std::atomic<bool> weight_stats{false};
+  W min_weight = kNoEdge;
+  W max_weight = kNoEdge;
+  bool uniform = false;
+  std::atomic<bool> fingerprinted{false};
+  std::uint64_t fingerprint = 0;
+};
+
+template <typename W>
+std::shared_ptr<typename BasicGraph<W>::Cache> BasicGraph<W>::GetCache()
+    const {
+  std::shared_ptr<Cache> cache = std::atomic_load(&cache_);
+  if (cache == nullptr) {
+    auto fresh = std::make_shared<Cache>();
+    // Another reader may have won the race; then cache is set to its one.
+    if (std::atomic_compare_exchange_strong(&cache_, &cache, fresh)) {
+      cache = std::move(fresh);
+    }
+  }
+  return cache;
+}
+
+template <typename W>
+std::shared_ptr<const typename BasicGraph<W>::csr_type> BasicGraph<W>::Csr()
+    const {
+  if (adj_list_ != nullptr) return adj_list_;
+  auto cache = GetCache();
+  return LoadOrBuild(&cache->mutex, &cache->csr, [this] {
+    using index_type = typename csr_type::index_type;
+    std::size_t const n = AmountOfVertices();
+    std::vector<std::size_t> offsets(n + 1, 0);
+    std::vector<index_type> columns;
+    std::vector<W> values;
+    for (std::size_t i = 0; i < n; i++) {
+      ForEachNeighbor(i, [&](std::size_t j, W weight) {
+        columns.push_back(static_cast<index_type>(j));
+        values.push_back(weight);
+      });
+      offsets[i + 1] = columns.size();
+    }
+    return std::make_shared<const csr_type>(
+        n, n, std::move(offsets), std::move(columns), std::move(values));
+  });
+}
+
+template <typename W>
+std::shared_ptr<const typename BasicGraph<W>::csr_type>
+BasicGraph<W>::ReverseCsr() const {
+  if (!IsDirected()) return Csr();
+  auto const forward = Csr();
+  auto cache = GetCache();
+  return LoadOrBuild(&cache->mutex, &cache->reverse, [&forward] {
+    using index_type = typename csr_type::index_type;
+    std::size_t const n = forward->GetRows();
+    std::size_t const arcs = forward->GetNonZeros();
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t k = 0; k < arcs; k++) {
+      offsets[forward->Columns()[k] + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+    std::vector<index_type> columns(arcs);
+    std::vector<W> values(arcs);
+    // Sources are visited in increasing order, so every reversed row comes
+    // out sorted.
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t k = forward->RowBegin(i); k < forward->RowEnd(i);
+           k++) {
+        std::size_t const slot = next[forward->Columns()[k]]++;
+        columns[slot] = static_cast<index_type>(i);
+        values[slot] = forward->Values()[k];
+      }
+    }
+    return std::make_shared<const csr_type>(
+        n, n, std::move(offsets), std::move(columns), std::move(values));
+  });
+}
+
+template <typename W>
+std::shared_ptr<const std::vector<std::size_t>> BasicGraph<W>::OutDegrees()
+    const {
+  auto cache = GetCache();
+  return LoadOrBuild(&cache->mutex, &cache->degrees, [this] {
+    std::size_t const n = AmountOfVertices();
+    auto degrees = std::make_shared<std::vector<std::size_t>>(n, 0);
+    for (std::size_t i = 0; i < n; i++) {
+      ForEachNeighbor(i, [&degrees, i](std::size_t, W) { (*degrees)[i]++; });
+    }
+    return degrees;
+  });
+}
+
+template <typename W>
+std::shared_ptr<const typename BasicGraph<W>::SortedNeighbors>
+BasicGraph<W>::NeighborsByWeight() const {
+  auto const adjacency = Csr();
+  auto cache = GetCache();
+  return LoadOrBuild(&cache->mutex, &cache->by_weight, [&adjacency] {
+    std::size_t const n = adjacency->GetRows();
+    std::size_t const arcs = adjacency->GetNonZeros();
+    auto sorted = std::make_shared<SortedNeighbors>();
+    sorted->offsets.assign(n + 1, 0);
+    for (std::size_t i = 0; i < n; i++) {
+      sorted->offsets[i + 1] = adjacency->RowEnd(i);
+    }
+    sorted->targets.resize(arcs);
+    sorted->weights.resize(arcs);
+    std::vector<std::size_t> slots;
+    for (std::size_t i = 0; i < n; i++) {
+      std::size_t const begin = sorted->offsets[i];
+      std::size_t const end = sorted->offsets[i + 1];
+      slots.resize(end - begin);
+      std::iota(slots.begin(), slots.end(), begin);
+      // The row is sorted by target, so a stable sort breaks ties by it.
+      std::stable_sort(slots.begin(), slots.end(),
+                       [adjacency](std::size_t a, std::size_t b) {
+                         return adjacency->Values()[a] <
+                                adjacency->Values()[b];
+                       });
+      for (std::size_t k = begin; k < end; k++) {
+        sorted->targets[k] = adjacency->Columns()[slots[k - begin]];
+        sorted->weights[k] = adjacency->Values()[slots[k - begin]];
+      }
+    }
+    return sorted;
+  });
+}
+
+template <typename W>
+std::shared_ptr<const std::vector<std::size_t>>
+BasicGraph<W>::ArcsByOriginalId() const {
+  auto const adjacency = Csr();
+  auto cache = GetCache();
+  return LoadOrBuild(&cache->mutex, &cache->by_original_id, [&] {
+    auto arcs = std::make_shared<std::vector<std::size_t>>(
+        adjacency->GetNonZeros());
+    std::iota(arcs->begin(), arcs->end(), 0);
+    if (order_ == nullptr) return arcs;
+    for (std::size_t i = 0; i < adjacency->GetRows(); i++) {
+      std::sort(arcs->begin() + (std::ptrdiff_t)adjacency->RowBegin(i),
+                arcs->begin() + (std::ptrdiff_t)adjacency->RowEnd(i),
+                [this, &adjacency](std::size_t a, std::size_t b) {
+                  return ToOriginalId(adjacency->Columns()[a]) <
+                         ToOriginalId(adjacency->Columns()[b]);
+                });
+    }
+    return arcs;
+  });
+}
+
+template <typename W>
+bool BasicGraph<W>::IsDirected() const {
+  if (adj_tri_ != nullptr) return false;
+  auto cache = GetCache();
+  auto state = cache->symmetric.load(std::memory_order_acquire);
+  if (state != Cache::Tristate::kUnknown) {
+    return state == Cache::Tristate::kNo;
+  }
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  state = cache->symmetric.load(std::memory_order_relaxed);
+  if (state == Cache::Tristate::kUnknown) {
+    bool symmetric = true;
+    for (size_t i = 0; i < AmountOfVertices() && symmetric; i++) {
+      ForEachNeighbor(i, [this, i, &symmetric](std::size_t j, W weight) {
+        if (StorageCell(j, i) != weight) symmetric = false;
+      });
+    }
+    state = symmetric ? Cache::Tristate::kYes : Cache::Tristate::kNo;
+    cache->symmetric.store(state, std::memory_order_release);
+  }
+  return state == Cache::Tristate::kNo;
+}
+
+template <typename W>
+void BasicGraph<W>::AssumeDirected(bool directed) const {
+  auto cache = GetCache();
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  cache->symmetric.store(
+      directed ? Cache::Tristate::kNo : Cache::Tristate::kYes,
+      std::memory_order_release);
+}
+
+template <typename W>
+W BasicGraph<W>::MinWeight() const {
+  auto cache = GetCache();
+  ComputeWeightStats(cache.get());
+  return cache->min_weight;
+}
+
+template <typename W>
+W BasicGraph<W>::MaxWeight() const {
+  auto cache = GetCache();
+  ComputeWeightStats(cache.get());
+  return cache->max_weight;
+}
+
+template <typename W>
+bool BasicGraph<W>::HasUniformWeights() const {
+  auto cache = GetCache();
+  ComputeWeightStats(cache.get());
+  return cache->uniform;
+}
+
+template <typename W>
+std::uint64_t BasicGraph<W>::Fingerprint() const {
+  bool const directed = IsDirected();
+  auto cache = GetCache();
+  if (cache->fingerprinted.load(std::memory_order_acquire)) {
+    return cache->fingerprint;
+  }
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  if (!cache->fingerprinted.load(std::memory_order_relaxed)) {
+    // The arcs are summed, so the order a reordered storage visits them in
+    // does not matter.
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < AmountOfVertices(); i++) {
+      std::uint64_t const from = Mix(ToOriginalId(i));
+      ForEachNeighbor(i, [&](std::size_t j, W weight) {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &weight, sizeof(weight));
+        sum += Mix(Mix(from ^ ToOriginalId(j)) ^ bits);
+      });
+    }
+    cache->fingerprint =
+        Mix(sum ^ Mix(AmountOfVertices() * 2 + (directed ? 1 : 0)));
+    cache->fingerprinted.store(true, std::memory_order_release);
+  }
+  return cache->fingerprint;
+}
+
+// Takes the cache mutex only while the statistics are not yet published.
+template <typename W>
+void BasicGraph<W>::ComputeWeightStats(Cache* cache) const {
+  if (cache->weight_stats.load(std::memory_order_acquire)) return;
+  std::lock_guard<std::mutex> lock(cache->mutex);
+  if (cache->weight_stats.load(std::memory_order_relaxed)) return;
+  bool any = false;
+  W min_weight = kNoEdge;
+  W max_weight = kNoEdge;
+  for (std::size_t i = 0; i < AmountOfVertices(); i++) {
+    ForEachNeighbor(i, [&](std::size_t, W weight) {
+      min_weight = any ? std::min(min_weight, weight) : weight;
+      max_weight = any ? std::max(max_weight, weight) : weight;
+      any = true;
+    });
+  }
+  cache->min_weight = min_weight;
+  cache->max_weight = max_weight;
+  cache->uniform = any && min_weight == max_weight;
+  cache->weight_stats.store(true, std::memory_order_release);
+}
+
+#define S21_INSTANTIATE_GRAPH_CACHE(W)                                       \
+  template std::shared_ptr<BasicGraph<W>::Cache> BasicGraph<W>::GetCache()   \
+      const;                                                                 \
+  template std::shared_ptr<const BasicGraph<W>::csr_type>                    \
+  BasicGraph<W>::Csr() const;                                                \
+  template std::shared_ptr<const BasicGraph<W>::csr_type>                    \
+  BasicGraph<W>::ReverseCsr() const;                                         \
+  template std::shared_ptr<const std::vector<std::size_t>>                   \
+  BasicGraph<W>::OutDegrees() const;                                         \
+  template std::shared_ptr<const BasicGraph<W>::SortedNeighbors>             \
+  BasicGraph<W>::NeighborsByWeight() const;                                  \
+  template std::shared_ptr<const std::vector<std::size_t>>                   \
+  BasicGraph<W>::ArcsByOriginalId() const;                                   \
+  template bool BasicGraph<W>::IsDirected() const;                           \
+  template void BasicGraph<W>::AssumeDirected(bool) const;                   \
+  template W BasicGraph<W>::MinWeight() const;                               \
+  template W BasicGraph<W>::MaxWeight() const;                               \
+  template bool BasicGraph<W>::HasUniformWeights() const;                    \
+  template std::uint64_t BasicGraph<W>::Fingerprint() const;                 \
+  template void BasicGraph<W>::ComputeWeightStats(Cache*) const;
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_GRAPH_CACHE)
+
+#undef S21_INSTANTIATE_GRAPH_CACHE
+
+}  // namespace s21
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <numeric>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+namespace {
+
+// Breadth-first discovery order of all vertices, one component after
+// another, taking the roots in the order given. With degrees the
+// neighbours of a vertex are queued by increasing degree, which makes it
+// the Cuthill-McKee order.
+template <typename Graph>
+std::vector<std::size_t> BreadthFirstOrder(
+    const Graph& graph, const std::vector<std::size_t>& roots,
+    const std::vector<std::size_t>* degrees) {
+  std::vector<std::size_t> order;
+  order.reserve(roots.size());
+  std::vector<bool> visited(roots.size(), false);
+  std::vector<std::size_t> neighbors;
+  for (std::size_t root : roots) {
+    if (visited[root]) continue;
+    visited[root] = true;
+    order.push_back(root);
+    for (std::size_t head = order.size() - 1; head < order.size(); head++) {
+      neighbors.clear();
+      graph.ForEachNeighbor(order[head], [&](std::size_t to, auto) {
+        if (!visited[to]) {
+          visited[to] = true;
+          neighbors.push_back(to);
+        }
+      });
+      if (degrees != nullptr) {
+        std::stable_sort(neighbors.begin(), neighbors.end(),
+                         [degrees](std::size_t a, std::size_t b) {
+                           return (*degrees)[a] < (*degrees)[b];
+                         });
+      }
+      order.insert(order.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+  return order;
+}
+
+}  // namespace
+
+template <typename W>
+void BasicGraph<W>::Reorder(VertexOrder order) {
+  std::size_t const n = AmountOfVertices();
+  std::vector<std::size_t> next(n);
+  auto const degree_array = OutDegrees();
+  const std::vector<std::size_t>& degrees = *degree_array;
+  std::vector<std::size_t> by_degree(n);
+  std::iota(by_degree.begin(), by_degree.end(), std::size_t(0));
+  std::stable_sort(by_degree.begin(), by_degree.end(),
+                   [&degrees](std::size_t a, std::size_t b) {
+                     return degrees[a] < degrees[b];
+                   });
+
+  switch (order) {
+    case VertexOrder::kOriginal:
+      for (std::size_t k = 0; k < n; k++) next[k] = ToStorageId(k);
+      break;
+    case VertexOrder::kReverseCuthillMcKee:
+      next = BreadthFirstOrder(*this, by_degree, &degrees);
+      std::reverse(next.begin(), next.end());
+      break;
+    case VertexOrder::kBreadthFirst:
+      std::iota(next.begin(), next.end(), std::size_t(0));
+      next = BreadthFirstOrder(*this, next, nullptr);
+      break;
+    case VertexOrder::kDegree:
+      std::iota(next.begin(), next.end(), std::size_t(0));
+      std::stable_sort(next.begin(), next.end(),
+                       [&degrees](std::size_t a, std::size_t b) {
+                         return degrees[a] > degrees[b];
+                       });
+      break;
+  }
+  Permute(std::move(next));
+}
+
+template <typename W>
+bool BasicGraph<W>::IsReordered() const {
+  return order_ != nullptr;
+}
+
+template <typename W>
+std::size_t BasicGraph<W>::ToStorageId(std::size_t vertex) const {
+  if (order_ == nullptr) return vertex;
+  if (vertex >= order_->to_storage.size()) {
+    throw std::out_of_range("ToStorageId: vertex is out of range");
+  }
+  return order_->to_storage[vertex];
+}
+
+template <typename W>
+std::size_t BasicGraph<W>::ToOriginalId(std::size_t vertex) const {
+  if (order_ == nullptr) return vertex;
+  if (vertex >= order_->to_original.size()) {
+    throw std::out_of_range("ToOriginalId: vertex is out of range");
+  }
+  return order_->to_original[vertex];
+}
+
+// next[k] is the storage id of the vertex that moves to position k.
+template <typename W>
+void BasicGraph<W>::Permute(std::vector<std::size_t> next) {
+  std::size_t const n = next.size();
+  std::atomic_store(&cache_, std::shared_ptr<Cache>());
+  std::vector<std::size_t> position(n);
+  for (std::size_t k = 0; k < n; k++) position[next[k]] = k;
+
+  if (adj_list_ != nullptr) {
+    using index_type = typename csr_type::index_type;
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t k = 0; k < n; k++) {
+      offsets[k + 1] = offsets[k] + adj_list_->RowEnd(next[k]) -
+                       adj_list_->RowBegin(next[k]);
+    }
+    std::vector<index_type> columns(offsets[n]);
+    std::vector<W> values(offsets[n]);
+    std::vector<std::pair<index_type, W>> row;
+    for (std::size_t k = 0; k < n; k++) {
+      row.clear();
+      ForEachNeighbor(next[k], [&](std::size_t to, W weight) {
+        row.emplace_back(static_cast<index_type>(position[to]), weight);
+      });
+      std::sort(row.begin(), row.end());
+      for (std::size_t c = 0; c < row.size(); c++) {
+        columns[offsets[k] + c] = row[c].first;
+        values[offsets[k] + c] = row[c].second;
+      }
+    }
+    adj_list_ = std::make_shared<csr_type>(n, n, std::move(offsets),
+                                           std::move(columns),
+                                           std::move(values));
+  } else if (adj_tri_ != nullptr) {
+    auto triangular = std::make_shared<triangular_type>(n);
+    for (std::size_t i = 0; i < n; i++) {
+      ForEachNeighbor(i, [&](std::size_t j, W weight) {
+        if (j >= i) (*triangular)(position[i], position[j]) = weight;
+      });
+    }
+    adj_tri_ = std::move(triangular);
+  } else if (n > 0) {
+    auto matrix = std::make_shared<matrix_type>(n, n);
+    for (std::size_t i = 0; i < n; i++) {
+      const W* row = adj_matrix_->Row(i);
+      W* permuted = matrix->Row(position[i]);
+      for (std::size_t j = 0; j < n; j++) permuted[position[j]] = row[j];
+    }
+    adj_matrix_ = std::move(matrix);
+  }
+
+  auto permutation = std::make_shared<Permutation>();
+  permutation->to_original.resize(n);
+  permutation->to_storage.resize(n);
+  bool identity = true;
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t const original = ToOriginalId(next[k]);
+    permutation->to_original[k] = original;
+    permutation->to_storage[original] = k;
+    identity = identity && original == k;
+  }
+  if (identity) {
+    order_.reset();
+  } else {
+    order_ = std::move(permutation);
+  }
+}
+
+#define S21_INSTANTIATE_GRAPH_ORDER(W)                                   \
+  template void BasicGraph<W>::Reorder(VertexOrder);                     \
+  template bool BasicGraph<W>::IsReordered() const;                      \
+  template std::size_t BasicGraph<W>::ToStorageId(std::size_t) const;    \
+  template std::size_t BasicGraph<W>::ToOriginalId(std::size_t) const;   \
+  template void BasicGraph<W>::Permute(std::vector<std::size_t>);
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_GRAPH_ORDER)
+
+#undef S21_INSTANTIATE_GRAPH_ORDER
+
+}  // namespace s21
@@ -0,0 +1,34 @@
+#include "s21_graph_publisher.h"
+
+namespace s21 {
+
+template <typename W>
+BasicGraphPublisher<W>::BasicGraphPublisher()
+    : current_(std::make_shared<const graph_type>()) {}
+
+template <typename W>
+BasicGraphPublisher<W>::BasicGraphPublisher(graph_type graph)
+    : current_(std::make_shared<const graph_type>(std::move(graph))) {}
+
+template <typename W>
+typename BasicGraphPublisher<W>::snapshot_type
+BasicGraphPublisher<W>::Snapshot() const {
+  return std::atomic_load(&current_);
+}
+
+template <typename W>
+void BasicGraphPublisher<W>::Publish(graph_type graph) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  PublishLocked(std::move(graph));
+}
+
+template <typename W>
+void BasicGraphPublisher<W>::PublishLocked(graph_type graph) {
+  std::atomic_store(&current_,
+                    snapshot_type(std::make_shared<const graph_type>(
+                        std::move(graph))));
+}
+
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicGraphPublisher)
+
+}  // namespace s21
@@ -0,0 +1,65 @@
+#ifndef SRC_GRAPH_S21_GRAPH_PUBLISHER_H_
+#define SRC_GRAPH_S21_GRAPH_PUBLISHER_H_
+
+#include <memory>
+#include <mutex>
+
+#include "s21_graph.h"
+
+namespace s21 {
+
+// Publishes immutable versions of a graph in the read-copy-update way.
+// Readers take the current snapshot and keep using it for as long as they
+// like, without ever waiting for a writer. A writer copies the current
+// snapshot (cheap, the storage is copied on the first write only and the
+// change log holds one update, see Update), updates the copy and
+// publishes it by swapping one pointer; the old version is freed when its
+// last reader lets it go.
+template <typename W>
+class BasicGraphPublisher {
+ public:
+  using graph_type = BasicGraph<W>;
+  using snapshot_type = std::shared_ptr<const graph_type>;
+
+  BasicGraphPublisher();
+  explicit BasicGraphPublisher(graph_type graph);
+
+  snapshot_type Snapshot() const;
+  // Replaces the current version; waits for a running Update.
+  void Publish(graph_type graph);
+
+  // Applies update(graph_type*) to a copy of the current version and
+  // publishes the result. Concurrent Update and Publish calls run one
+  // after another, so no published version is lost.
+  // The copy's change log is trimmed to the current version first, so a
+  // published version only logs the changes since the one before it:
+  // ChangesSince(previous->Version()) works, older versions do not. This
+  // keeps an update from copying every change ever made.
+  template <typename Function>
+  void Update(Function&& update);
+
+ private:
+  snapshot_type current_;
+  std::mutex writer_mutex_;
+
+  // Publish with writer_mutex_ held.
+  void PublishLocked(graph_type graph);
+};
+
+using GraphPublisher = BasicGraphPublisher<int>;
+
+S21_DECLARE_FOR_CELL_TYPES(BasicGraphPublisher)
+
+template <typename W>
+template <typename Function>
+void BasicGraphPublisher<W>::Update(Function&& update) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  graph_type next(*Snapshot());
+  next.TrimChangeLog(next.Version());
+  update(&next);
+  PublishLocked(std::move(next));
+}
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_S21_GRAPH_PUBLISHER_H_
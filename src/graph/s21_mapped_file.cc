@@ -0,0 +1,45 @@
+#include "s21_mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+namespace s21 {
+
+MappedFile::MappedFile(const std::string& filename) {
+  int const fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw std::runtime_error("Could not open file");
+  }
+  struct stat info;
+  if (fstat(fd, &info) == -1) {
+    close(fd);
+    throw std::runtime_error("Could not read file size");
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                      0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map file");
+    }
+    data_ = static_cast<char*>(data);
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) munmap(data_, size_);
+}
+
+char* MappedFile::Data() { return data_; }
+
+const char* MappedFile::Data() const { return data_; }
+
+std::size_t MappedFile::Size() const { return size_; }
+
+}  // namespace s21
@@ -0,0 +1,31 @@
+#ifndef SRC_GRAPH_S21_MAPPED_FILE_H_
+#define SRC_GRAPH_S21_MAPPED_FILE_H_
+
+#include <string>
+
+namespace s21 {
+
+// Private copy-on-write memory mapping of a whole file: pages are loaded on
+// first access and writes never reach the file.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& filename);
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile(MappedFile&& other) = delete;
+  ~MappedFile();
+
+  MappedFile& operator=(const MappedFile& other) = delete;
+  MappedFile& operator=(MappedFile&& other) = delete;
+
+  char* Data();
+  const char* Data() const;
+  std::size_t Size() const;
+
+ private:
+  char* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_S21_MAPPED_FILE_H_
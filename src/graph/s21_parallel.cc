@@ -0,0 +1,83 @@
+#include "s21_parallel.h"
+
+namespace s21 {
+
+ThreadPool::ThreadPool(unsigned threads) {
+  threads = ResolveThreads(threads);
+  workers_.reserve(threads - 1);
+  try {
+    for (unsigned t = 1; t < threads; t++) {
+      workers_.emplace_back(&ThreadPool::Work, this, t);
+    }
+  } catch (...) {
+    // The destructor does not run for a throwing constructor: stop the
+    // started workers here, destroying them joinable would terminate.
+    Stop();
+    throw;
+  }
+}
+
+ThreadPool::~ThreadPool() { Stop(); }
+
+void ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+unsigned ThreadPool::GetThreads() const {
+  return static_cast<unsigned>(workers_.size() + 1);
+}
+
+void ThreadPool::Run(const task_type& task) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    running_ = workers_.size();
+    error_ = nullptr;
+    generation_++;
+  }
+  start_.notify_all();
+  Call(task, 0);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+    task_ = nullptr;
+    std::swap(error, error_);
+  }
+  if (error != nullptr) std::rethrow_exception(error);
+}
+
+void ThreadPool::Work(unsigned t) {
+  std::uint64_t seen = 0;
+  for (;;) {
+    const task_type* task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      task = task_;
+    }
+    Call(*task, t);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--running_ == 0) done_.notify_one();
+  }
+}
+
+void ThreadPool::Call(const task_type& task, unsigned t) {
+  try {
+    task(t);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_ == nullptr) error_ = std::current_exception();
+  }
+}
+
+}  // namespace s21
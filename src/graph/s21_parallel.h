@@ -0,0 +1,92 @@
+#ifndef SRC_GRAPH_S21_PARALLEL_H_
+#define SRC_GRAPH_S21_PARALLEL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// The number of workers to use when the caller asks for threads of them,
+// 0 meaning the hardware concurrency.
+inline unsigned ResolveThreads(unsigned threads) {
+  if (threads != 0) return threads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls function(t) for t = 0 .. threads - 1, t = 0 on the calling thread
+// and the others on threads of their own, and waits for all of them; 0
+// threads is taken as 1. The first exception (by t) any call threw is
+// rethrown after the join.
+template <typename Function>
+void RunParallel(unsigned threads, Function&& function) {
+  threads = std::max(threads, 1u);
+  std::vector<std::exception_ptr> errors(threads);
+  auto const call = [&function, &errors](unsigned t) {
+    try {
+      function(t);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  try {
+    for (unsigned t = 1; t < threads; t++) workers.emplace_back(call, t);
+  } catch (...) {
+    // Could not start a thread: let the started ones finish first.
+    errors[0] = std::current_exception();
+  }
+  if (errors[0] == nullptr) call(0u);
+  for (std::thread& worker : workers) worker.join();
+  for (const std::exception_ptr& error : errors) {
+    if (error != nullptr) std::rethrow_exception(error);
+  }
+}
+
+// RunParallel with threads that are started once and then wait for work,
+// for algorithms that fork and join many times (e.g. once per BFS level).
+class ThreadPool {
+ public:
+  using task_type = std::function<void(unsigned)>;
+
+  // threads workers including the calling one, 0 meaning the hardware
+  // concurrency.
+  explicit ThreadPool(unsigned threads = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  unsigned GetThreads() const;
+
+  // Calls task(t) for t = 0 .. GetThreads() - 1, t = 0 on the calling
+  // thread, and returns when all calls have returned, rethrowing the first
+  // exception any of them threw. Concurrent Run calls take turns.
+  void Run(const task_type& task);
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  const task_type* task_ = nullptr;
+  std::uint64_t generation_ = 0;
+  std::size_t running_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+
+  // Wakes the workers to return and joins them.
+  void Stop();
+  void Work(unsigned t);
+  void Call(const task_type& task, unsigned t);
+};
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_S21_PARALLEL_H_
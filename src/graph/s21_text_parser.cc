@@ -0,0 +1,198 @@
+#include "s21_text_parser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <vector>
+
+#include "s21_parallel.h"
+
+namespace s21 {
+
+namespace parser {
+
+namespace {
+
+// Chunks smaller than this are not worth a thread of their own.
+constexpr std::size_t kMinChunkSize = 1 << 20;
+
+std::size_t CountNumbers(const char* first, const char* last) {
+  std::size_t count = 0;
+  bool in_number = false;
+  for (; first != last; ++first) {
+    bool const space = IsSpace(*first);
+    if (!space && !in_number) count++;
+    in_number = !space;
+  }
+  return count;
+}
+
+const char* SkipNumber(const char* first, const char* last) {
+  first = SkipSpaces(first, last);
+  while (first != last && !IsSpace(*first)) ++first;
+  return first;
+}
+
+// The text split into up to threads chunks at whitespace: chunk t is
+// [bounds[t], bounds[t + 1]) and its first number is number starts[t].
+struct Chunks {
+  unsigned threads;
+  std::vector<const char*> bounds;
+  std::vector<std::size_t> starts;
+};
+
+// Throws std::runtime_error if the text has fewer than cells numbers.
+Chunks SplitText(const char* first, const char* last, std::size_t cells,
+                 unsigned threads) {
+  std::size_t const size = static_cast<std::size_t>(last - first);
+  if (threads == 0) {
+    threads = (unsigned)std::min<std::size_t>(ResolveThreads(0),
+                                              size / kMinChunkSize + 1);
+  }
+
+  Chunks chunks{threads, std::vector<const char*>(threads + 1, last),
+                std::vector<std::size_t>(threads + 1, 0)};
+  std::vector<const char*>& bounds = chunks.bounds;
+  std::vector<std::size_t>& starts = chunks.starts;
+  bounds[0] = first;
+  for (unsigned t = 1; t < threads; t++) {
+    const char* bound = std::max(first + size / threads * t, bounds[t - 1]);
+    while (bound != last && !IsSpace(*bound)) ++bound;
+    bounds[t] = bound;
+  }
+
+  RunParallel(threads, [&bounds, &starts](unsigned t) {
+    starts[t + 1] = CountNumbers(bounds[t], bounds[t + 1]);
+  });
+  for (unsigned t = 0; t < threads; t++) starts[t + 1] += starts[t];
+
+  if (starts[threads] < cells) {
+    throw std::runtime_error("Invalid graph file");
+  }
+  return chunks;
+}
+
+// Calls cell(position, chunk_end, row, col) for each of the first cells
+// numbers, every chunk on a worker of its own; cell returns the position
+// after the number, or nullptr to stop the chunk.
+template <typename Function>
+void ForEachCell(const Chunks& chunks, std::size_t cells, std::size_t cols,
+                 Function&& cell) {
+  if (cells == 0) return;
+  RunParallel(chunks.threads, [&](unsigned t) {
+    std::size_t const begin = chunks.starts[t];
+    std::size_t const end = std::min(chunks.starts[t + 1], cells);
+    std::size_t row = begin / cols, col = begin % cols;
+    const char* position = chunks.bounds[t];
+    for (std::size_t k = begin; k < end && position != nullptr; k++) {
+      position = cell(position, chunks.bounds[t + 1], row, col);
+      if (++col == cols) {
+        col = 0;
+        row++;
+      }
+    }
+  });
+}
+
+}  // namespace
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+const char* SkipSpaces(const char* first, const char* last) {
+  while (first != last && IsSpace(*first)) ++first;
+  return first;
+}
+
+template <typename Number>
+const char* ParseNumber(const char* first, const char* last, Number* value) {
+  first = SkipSpaces(first, last);
+  auto const [end, error] = std::from_chars(first, last, *value);
+  if (first == last || error != std::errc() ||
+      (end != last && !IsSpace(*end))) {
+    throw std::runtime_error("Invalid graph file");
+  }
+  return end;
+}
+
+template <typename T>
+void ParseMatrix(const char* first, const char* last, BasicMatrix<T>* matrix,
+                 unsigned threads) {
+  std::size_t const cols = matrix->GetColumns();
+  std::size_t const cells = matrix->GetRows() * cols;
+  Chunks const chunks = SplitText(first, last, cells, threads);
+  ForEachCell(chunks, cells, cols,
+              [matrix](const char* position, const char* end, std::size_t row,
+                       std::size_t col) {
+                return ParseNumber(position, end, matrix->Row(row) + col);
+              });
+}
+
+template <typename T>
+bool ParseSymmetricMatrix(const char* first, const char* last,
+                          BasicTriangularMatrix<T>* triangle,
+                          BasicMatrix<T>* matrix, unsigned threads) {
+  std::size_t const size = triangle->GetSize();
+  std::size_t const cells = size * size;
+  Chunks const chunks = SplitText(first, last, cells, threads);
+  // The upper half first, then the lower one against it, so that no
+  // worker compares a cell another one has yet to write. Each pass skips
+  // the numbers of the other half without parsing them.
+  ForEachCell(chunks, cells, size,
+              [triangle](const char* position, const char* end,
+                         std::size_t row, std::size_t col) {
+                if (col < row) return SkipNumber(position, end);
+                return ParseNumber(position, end,
+                                   triangle->RowTail(row) + (col - row));
+              });
+  std::atomic<bool> symmetric{true};
+  ForEachCell(chunks, cells, size,
+              [triangle, &symmetric](const char* position, const char* end,
+                                     std::size_t row,
+                                     std::size_t col) -> const char* {
+                if (col >= row) return SkipNumber(position, end);
+                T value;
+                position = ParseNumber(position, end, &value);
+                if (value != triangle->RowTail(col)[row - col]) {
+                  symmetric.store(false, std::memory_order_relaxed);
+                }
+                return symmetric.load(std::memory_order_relaxed) ? position
+                                                                  : nullptr;
+              });
+  if (symmetric) return true;
+
+  // The upper half is complete, the check stopped in the lower one: keep
+  // the former and parse the latter, on the same chunks.
+  *matrix = BasicMatrix<T>(size, size);
+  for (std::size_t row = 0; row < size; row++) {
+    std::copy(triangle->RowTail(row), triangle->RowTail(row) + (size - row),
+              matrix->Row(row) + row);
+  }
+  ForEachCell(chunks, cells, size,
+              [matrix](const char* position, const char* end, std::size_t row,
+                       std::size_t col) {
+                if (col >= row) return SkipNumber(position, end);
+                return ParseNumber(position, end, matrix->Row(row) + col);
+              });
+  return false;
+}
+
+template const char* ParseNumber(const char*, const char*, std::size_t*);
+
+#define S21_INSTANTIATE_TEXT_PARSER(T)                                      \
+  template const char* ParseNumber(const char*, const char*, T*);           \
+  template void ParseMatrix(const char*, const char*, BasicMatrix<T>*,      \
+                            unsigned);                                      \
+  template bool ParseSymmetricMatrix(const char*, const char*,              \
+                                     BasicTriangularMatrix<T>*,             \
+                                     BasicMatrix<T>*, unsigned);
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_TEXT_PARSER)
+
+#undef S21_INSTANTIATE_TEXT_PARSER
+
+}  // namespace parser
+
+}  // namespace s21
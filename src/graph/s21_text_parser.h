@@ -0,0 +1,45 @@
+#ifndef SRC_GRAPH_S21_TEXT_PARSER_H_
+#define SRC_GRAPH_S21_TEXT_PARSER_H_
+
+#include <cstddef>
+
+#include "../matrix/s21_matrix_oop.h"
+#include "../matrix/s21_triangular_matrix.h"
+
+namespace s21 {
+
+namespace parser {
+
+bool IsSpace(char c);
+const char* SkipSpaces(const char* first, const char* last);
+
+// Parse the whitespace separated number starting at first (leading
+// whitespace is skipped) and return the position right after it. Throw
+// std::runtime_error if there is no well-formed number. Instantiated for
+// std::size_t and the weight types of BasicMatrix.
+template <typename Number>
+const char* ParseNumber(const char* first, const char* last, Number* value);
+
+// Fill the matrix row by row with the first rows * cols numbers of the
+// text. The text is split into chunks at whitespace and parsed by up to
+// threads workers (0 picks the hardware concurrency); every worker counts
+// the numbers of its chunk first, so it knows the cell it starts at.
+template <typename T>
+void ParseMatrix(const char* first, const char* last, BasicMatrix<T>* matrix,
+                 unsigned threads = 0);
+
+// Fill the packed triangle with the upper half of the size * size matrix
+// of the text, parsed like ParseMatrix, and check the lower half against
+// it. Return false at the first cell that differs from its mirror, after
+// assigning the whole size * size matrix to *matrix: the upper half is
+// copied from the triangle and only the lower one is parsed again.
+template <typename T>
+bool ParseSymmetricMatrix(const char* first, const char* last,
+                          BasicTriangularMatrix<T>* triangle,
+                          BasicMatrix<T>* matrix, unsigned threads = 0);
+
+}  // namespace parser
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_S21_TEXT_PARSER_H_
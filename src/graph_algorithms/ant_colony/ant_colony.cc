@@ -6,23 +6,35 @@ namespace s21 {
 
 namespace tsm {
 
-TsmResult AntColony::FindOptimalPath(const Graph& graph) {
-  const int number_of_cities = (int)graph.AmountOfVertices();
-  std::vector<std::vector<double>> pheromone(number_of_cities);
+AntColony::AntColony() : gen_(std::random_device()()) {}
 
-  for (int i = 0; i < number_of_cities; i++)
-    for (int j = 0; j < number_of_cities; j++) {
-      pheromone[i].push_back(start_pheromone);
-    }
+AntColony::AntColony(std::uint32_t seed) : gen_(seed) {}
+
+template <typename W>
+TsmResult AntColony::FindOptimalPath(const BasicGraph<W>& graph) {
+  const int number_of_cities = (int)graph.AmountOfVertices();
 
   TsmResult best_path;
   best_path.distance = INFINITY;
+  if (number_of_cities == 0) return best_path;
+
+  BasicMatrix<float> pheromone(number_of_cities, number_of_cities);
+  BasicMatrix<float> proximity(number_of_cities, number_of_cities);
+  for (int i = 0; i < number_of_cities; i++) {
+    float* pheromone_row = pheromone.Row(i);
+    float* proximity_row = proximity.Row(i);
+    for (int j = 0; j < number_of_cities; j++) {
+      pheromone_row[j] = start_pheromone;
+      W const distance = graph(i, j);
+      proximity_row[j] = distance == 0 ? 0.f : 1.f / (float)distance;
+    }
+  }
 
   Ant regular_ant((int)number_of_cities);
   std::vector<Ant> ant_colony(number_of_cities, regular_ant);
 
   for (int i = 0; i < iteration; i++) {
-    SimulateAnts(graph, ant_colony, pheromone);
+    SimulateAnts(graph, proximity, ant_colony, pheromone);
     UpdatePheromone(ant_colony, pheromone);
     UpdateBestPath(ant_colony, best_path);
   }
@@ -30,50 +42,47 @@ TsmResult AntColony::FindOptimalPath(const Graph& graph) {
   return best_path;
 }
 
-void AntColony::SimulateAnts(
-    const Graph& graph, std::vector<Ant>& ant_colony,
-    const std::vector<std::vector<double>>& pheromone) {
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_real_distribution<> dis(0.0, 1.0);
+template <typename W>
+void AntColony::SimulateAnts(const BasicGraph<W>& graph,
+                             const BasicMatrix<float>& proximity,
+                             std::vector<Ant>& ant_colony,
+                             const BasicMatrix<float>& pheromone) {
+  std::uniform_real_distribution<float> dis(0.f, 1.f);
 
   const int number_of_cities = (int)graph.AmountOfVertices();
 
+  std::vector<float> cities_attraction(number_of_cities);
   int ant_num = 0;
   for (Ant& ant : ant_colony) {
     int current_city;
     std::vector<bool> visited(number_of_cities, false);
     current_city = ant_num % number_of_cities;
     ant.path[0] = current_city;
+    // The ants are reused by every iteration: without this their tours
+    // would add up and no iteration after the first could beat the best.
+    ant.distance = 0;
 
     for (int step = 1; step < number_of_cities; step++) {
       visited[current_city] = true;
-      double atraction_sum = 0;
+      float atraction_sum = 0;
 
-      std::vector<double> cities_attraction(number_of_cities, 0);
+      const float* pheromone_row = pheromone.Row(current_city);
+      const float* proximity_row = proximity.Row(current_city);
       for (int city_to = 0; city_to < number_of_cities; city_to++) {
-        double distance = (double)graph(current_city, city_to);
-        if (!visited[city_to] && distance != 0) {
-          double proximity = 1.0 / distance;
-          cities_attraction[city_to] =
-              pow(pheromone[current_city][city_to], alpha) *
-              pow((proximity), beta);
+        float attraction = 0;
+        if (!visited[city_to] && proximity_row[city_to] != 0) {
+          attraction = std::pow(pheromone_row[city_to], alpha) *
+                       std::pow(proximity_row[city_to], beta);
         }
-
-        atraction_sum += cities_attraction[city_to];
+        cities_attraction[city_to] = attraction;
+        atraction_sum += attraction;
       }
 
       if (atraction_sum != 0) {
-        cities_attraction[0] = cities_attraction[0] / atraction_sum;
-        for (int c = 1; c < number_of_cities; c++)
-          cities_attraction[c] =
-              cities_attraction[c - 1] + cities_attraction[c] / atraction_sum;
+        int city_to =
+            ChooseCity(cities_attraction, dis(gen_) * atraction_sum);
 
-        double ant_choise = dis(rd);
-        int city_to = 0;
-        while (ant_choise > cities_attraction[city_to]) city_to++;
-
-        ant.distance += graph(current_city, city_to);
+        ant.distance += (double)graph(current_city, city_to);
 
         ant.path.at(step) = city_to;
         current_city = city_to;
@@ -83,26 +92,41 @@ void AntColony::SimulateAnts(
       }
     }
 
-    int back_path = graph(ant.path.at(0), ant.path.at(number_of_cities - 1));
+    W const back_path =
+        graph(ant.path.at(0), ant.path.at(number_of_cities - 1));
     ant.distance += back_path == 0 ? INFINITY : (double)back_path;
     ant_num++;
   }
 }
 
+int AntColony::ChooseCity(const std::vector<float>& cities_attraction,
+                          float share) const {
+  int city_to = -1;
+  for (int c = 0; c < (int)cities_attraction.size(); c++) {
+    if (cities_attraction[c] == 0) continue;
+    city_to = c;
+    share -= cities_attraction[c];
+    if (share <= 0) break;
+  }
+  return city_to;
+}
+
 void AntColony::UpdatePheromone(const std::vector<Ant>& ant_colony,
-                                std::vector<std::vector<double>>& pheromone) {
-  for (size_t i = 0; i < pheromone.size(); i++)
-    for (size_t j = 0; j < pheromone[i].size(); j++)
-      pheromone[i][j] = (1 - p) * pheromone[i][j];
+                                BasicMatrix<float>& pheromone) {
+  pheromone *= 1 - p;
 
-  for (Ant ant : ant_colony) {
-    double pheromone_add = Q / ant.distance;
+  for (const Ant& ant : ant_colony) {
+    // An ant stuck before closing its tour has an infinite distance and a
+    // path tail left over from the previous run: depositing Q / inf would
+    // zero those edges and no later ant could ever walk them.
+    if (std::isinf(ant.distance)) continue;
+    float pheromone_add = (float)(Q / ant.distance);
 
     for (size_t city = 1; city < ant.path.size(); city++) {
       int to = ant.path[city];
       int from = ant.path[city - 1];
-      pheromone[from][to] = pheromone_add;
-      pheromone[to][from] = pheromone[from][to];
+      pheromone(from, to) = pheromone_add;
+      pheromone(to, from) = pheromone(from, to);
     }
   }
 }
@@ -116,6 +140,14 @@ void AntColony::UpdateBestPath(const std::vector<Ant>& ant_colony,
     }
 }
 
+#define S21_INSTANTIATE_ANT_COLONY(W)                                      \
+  template TsmResult AntColony::FindOptimalPath(const BasicGraph<W>&);     \
+  template void AntColony::SimulateAnts(                                   \
+      const BasicGraph<W>&, const BasicMatrix<float>&, std::vector<Ant>&, \
+      const BasicMatrix<float>&);
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_ANT_COLONY)
+
 }  // namespace tsm
 
 }  // namespace s21
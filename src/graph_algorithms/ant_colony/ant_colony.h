@@ -2,6 +2,7 @@
 #define SRC_GRAPH_ALGORITHMS_ANT_COLONY_ANT_COLONY_H_
 
 #include <cmath>
+#include <cstdint>
 #include <random>
 #include <vector>
 
@@ -18,9 +19,19 @@ struct TsmResult {
 
 class AntColony {
  public:
-  TsmResult FindOptimalPath(const Graph& graph);
+  // The ants draw from a generator seeded by the random device, or by the
+  // given seed, which makes the runs reproducible.
+  AntColony();
+  explicit AntColony(std::uint32_t seed);
 
- private:
+  // Works on every weight type BasicGraph is instantiated for; the
+  // proximities are computed straight from the graph's weights.
+  template <typename W>
+  TsmResult FindOptimalPath(const BasicGraph<W>& graph);
+
+ protected:
+  // The steps of a run, open to derived classes so that each can be
+  // checked on its own.
   struct Ant {
     std::vector<int> path;
     double distance;
@@ -29,22 +40,31 @@ class AntColony {
         : path(number_of_cities, 0), distance(0) {}
   };
 
-  const double alpha = 1;
-  const double beta = 1.;
-  const double start_pheromone = 0.2;
+  // Pheromone and proximity (1 / distance) are kept as float matrices, so
+  // the attraction loop works on one type without conversions.
+  const float alpha = 1.f;
+  const float beta = 1.f;
+  const float start_pheromone = 0.2f;
   const int Q = 240;
-  const double p = 0.64;
+  const float p = 0.64f;
 
   const int iteration = 10;
 
-  double Antraction(const Graph& graph,
-                    const std::vector<std::vector<double>>& pheromone, int from,
-                    int to);
+  std::mt19937 gen_;
 
-  void SimulateAnts(const Graph& graph, std::vector<Ant>& ant_colony,
-                    const std::vector<std::vector<double>>& pheromone);
+  template <typename W>
+  void SimulateAnts(const BasicGraph<W>& graph,
+                    const BasicMatrix<float>& proximity,
+                    std::vector<Ant>& ant_colony,
+                    const BasicMatrix<float>& pheromone);
+  // Roulette-wheel selection: walks the attractions until share, a
+  // uniform draw scaled by their sum, is used up. A city without
+  // attraction is never taken; when rounding leaves a remainder, the last
+  // attractive city is.
+  int ChooseCity(const std::vector<float>& cities_attraction,
+                 float share) const;
   void UpdatePheromone(const std::vector<Ant>& ant_colony,
-                       std::vector<std::vector<double>>& pheromone);
+                       BasicMatrix<float>& pheromone);
   void UpdateBestPath(const std::vector<Ant>& ant_colony, TsmResult& best_path);
 };
 
@@ -0,0 +1,119 @@
+#ifndef SRC_GRAPH_ALGORITHMS_S21_BUCKET_QUEUES_H_
+#define SRC_GRAPH_ALGORITHMS_S21_BUCKET_QUEUES_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Monotone priority queues of vertices keyed by non-negative integer
+// distances: a pushed key is never below the last popped one, which is
+// all Dijkstra needs and lets both queues do without comparisons between
+// keys. A vertex may be pushed again with a smaller key; the caller skips
+// the stale entries. Defined here so they inline into the searches.
+
+// Dial's queue: a ring of max_step + 1 buckets, one per distance, where
+// max_step bounds how far above the last popped key a key may be (the
+// largest arc weight). Push is O(1), and popping walks over the empty
+// buckets between two distances. The ring is allocated up front, so Reset
+// throws std::invalid_argument above kMaxStep; use a RadixHeap there.
+class BucketQueue {
+ public:
+  using entry = std::pair<std::uint64_t, std::size_t>;
+
+  static constexpr std::uint64_t kMaxStep = std::uint64_t{1} << 20;
+
+  void Reset(std::uint64_t max_step) {
+    if (max_step > kMaxStep) {
+      throw std::invalid_argument("too many buckets for Dial's queue");
+    }
+    ring_ = static_cast<std::size_t>(max_step) + 1;
+    if (buckets_.size() < ring_) buckets_.resize(ring_);
+    for (std::size_t b = 0; b < ring_; b++) buckets_[b].clear();
+    current_ = 0;
+    size_ = 0;
+  }
+
+  bool Empty() const { return size_ == 0; }
+
+  void Push(std::uint64_t key, std::size_t vertex) {
+    buckets_[static_cast<std::size_t>(key % ring_)].push_back(vertex);
+    size_++;
+  }
+
+  entry Pop() {
+    while (buckets_[static_cast<std::size_t>(current_ % ring_)].empty()) {
+      current_++;
+    }
+    std::vector<std::size_t>& bucket =
+        buckets_[static_cast<std::size_t>(current_ % ring_)];
+    std::size_t const vertex = bucket.back();
+    bucket.pop_back();
+    size_--;
+    return entry(current_, vertex);
+  }
+
+ private:
+  std::vector<std::vector<std::size_t>> buckets_;
+  std::size_t ring_ = 1;
+  std::uint64_t current_ = 0;
+  std::size_t size_ = 0;
+};
+
+// Radix heap: bucket b > 0 holds the keys whose highest bit differing from
+// the last popped key is bit b - 1, bucket 0 the keys equal to it. When
+// bucket 0 runs empty the lowest non-empty bucket is split by its minimum,
+// and since keys only move to lower buckets each one moves at most 64
+// times, whatever the weights.
+class RadixHeap {
+ public:
+  using entry = std::pair<std::uint64_t, std::size_t>;
+
+  void Reset() {
+    for (std::vector<entry>& bucket : buckets_) bucket.clear();
+    last_ = 0;
+    size_ = 0;
+  }
+
+  bool Empty() const { return size_ == 0; }
+
+  void Push(std::uint64_t key, std::size_t vertex) {
+    buckets_[Bucket(key)].emplace_back(key, vertex);
+    size_++;
+  }
+
+  entry Pop() {
+    if (buckets_[0].empty()) {
+      std::size_t b = 1;
+      while (buckets_[b].empty()) b++;
+      std::vector<entry>& split = buckets_[b];
+      last_ = split.front().first;
+      for (const entry& e : split) last_ = std::min(last_, e.first);
+      for (const entry& e : split) buckets_[Bucket(e.first)].push_back(e);
+      split.clear();
+    }
+    entry const top = buckets_[0].back();
+    buckets_[0].pop_back();
+    size_--;
+    return top;
+  }
+
+ private:
+  std::array<std::vector<entry>, 65> buckets_;
+  std::uint64_t last_ = 0;
+  std::size_t size_ = 0;
+
+  std::size_t Bucket(std::uint64_t key) const {
+    if (key == last_) return 0;
+    return static_cast<std::size_t>(64 - __builtin_clzll(key ^ last_));
+  }
+};
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_ALGORITHMS_S21_BUCKET_QUEUES_H_
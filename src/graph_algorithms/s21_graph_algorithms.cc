@@ -1,16 +1,365 @@
 #include "s21_graph_algorithms.h"
 
+#include <atomic>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <type_traits>
 
 namespace s21 {
 
-tsm::TsmResult GraphAlgoritms::SolveTravelingSalesmanProblem(Graph& graph) {
+namespace {
+
+// Appends the unvisited neighbours of the vertex to the output in
+// ascending order and marks them visited.
+void TakeUnvisitedNeighbors(const BitMatrix& adjacency, std::size_t vertex,
+                            std::vector<BitMatrix::word_type>* visited,
+                            std::vector<int>* output) {
+  const BitMatrix::word_type* row = adjacency.Row(vertex);
+  for (std::size_t w = 0; w < adjacency.GetWordsPerRow(); w++) {
+    BitMatrix::word_type fresh = row[w] & ~(*visited)[w];
+    (*visited)[w] |= fresh;
+    for (; fresh != 0; fresh &= fresh - 1) {
+      std::size_t const to =
+          w * BitMatrix::kWordBits + (std::size_t)BitMatrix::LowestBit(fresh);
+      output->push_back((int)to + 1);
+    }
+  }
+}
+
+void CheckStartVertex(std::size_t vertices, int startVertex) {
+  if (startVertex < 1 || (std::size_t)startVertex > vertices) {
+    throw std::out_of_range("startVertex is out of range");
+  }
+}
+
+// Every set column of a bit-packed adjacency is followed to its row.
+void CheckAdjacency(const BitMatrix& adjacency, int startVertex) {
+  if (adjacency.GetRows() != adjacency.GetColumns()) {
+    throw std::invalid_argument("Adjacency matrix must be square");
+  }
+  CheckStartVertex(adjacency.GetRows(), startVertex);
+}
+
+// Bidirectional BFS between storage ids: vertices found from the source
+// are visited, those found from the target over the reverse arcs are
+// reached, and their parents point towards the end they were found from.
+// Each step expands a whole level of the side with the smaller frontier
+// and stops at the first arc joining the two sides; since neither side
+// has expanded past it, that arc lies on a path with the fewest arcs.
+// Returns the number of arcs of the path and its joining arc (from, to),
+// or -1 if the target cannot be reached.
+template <typename W>
+int MeetInTheMiddle(const BasicGraph<W>& graph, std::size_t source,
+                    std::size_t target, BasicSearchWorkspace<W>* workspace,
+                    std::pair<std::size_t, std::size_t>* meeting) {
+  workspace->Reset(graph.AmountOfVertices());
+  workspace->Visit(source);
+  workspace->SetParent(source, source);
+  if (source == target) {
+    *meeting = {source, source};
+    return 0;
+  }
+  workspace->Reach(target);
+  workspace->SetParent(target, target);
+
+  std::vector<std::size_t>& forward = workspace->Frontier();
+  std::vector<std::size_t>& backward = workspace->ReverseFrontier();
+  forward.push_back(source);
+  backward.push_back(target);
+  std::size_t forward_begin = 0, backward_begin = 0;
+  int levels = 0;
+  auto const arcs = graph.Csr();
+  auto const reverse_arcs = graph.ReverseCsr();
+
+  while (forward_begin < forward.size() && backward_begin < backward.size()) {
+    bool const from_source =
+        forward.size() - forward_begin <= backward.size() - backward_begin;
+    auto const& adjacency = from_source ? *arcs : *reverse_arcs;
+    std::vector<std::size_t>& queue = from_source ? forward : backward;
+    std::size_t& begin = from_source ? forward_begin : backward_begin;
+    auto const own = [&](std::size_t v) {
+      return from_source ? workspace->IsVisited(v) : workspace->IsReached(v);
+    };
+    auto const others = [&](std::size_t v) {
+      return from_source ? workspace->IsReached(v) : workspace->IsVisited(v);
+    };
+    const auto* columns = adjacency.Columns();
+
+    levels++;
+    for (std::size_t const end = queue.size(); begin < end; begin++) {
+      std::size_t const from = queue[begin];
+      std::size_t const row_end = adjacency.RowEnd(from);
+      for (std::size_t k = adjacency.RowBegin(from); k < row_end; k++) {
+        std::size_t const to = columns[k];
+        if (own(to)) continue;
+        if (others(to)) {
+          *meeting = from_source ? std::make_pair(from, to)
+                                 : std::make_pair(to, from);
+          return levels;
+        }
+        if (from_source) {
+          workspace->Visit(to);
+        } else {
+          workspace->Reach(to);
+        }
+        workspace->SetParent(to, from);
+        queue.push_back(to);
+      }
+    }
+  }
+  return -1;
+}
+
+// Numbers the components given a label per storage id, any id of the
+// component, in the order of their smallest original vertex.
+template <typename W>
+GraphAlgoritms::Components NumberComponents(
+    const BasicGraph<W>& graph, const std::vector<std::size_t>& label) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  std::vector<int> number(vertices, -1);
+  GraphAlgoritms::Components components;
+  components.component.resize(vertices);
+  for (std::size_t v = 0; v < vertices; v++) {
+    int& id = number[label[graph.ToStorageId(v)]];
+    if (id < 0) id = components.count++;
+    components.component[v] = id;
+  }
+  return components;
+}
+
+// The root of the union-find tree of v, halving the path on the way.
+std::size_t FindRoot(std::vector<std::size_t>* parent, std::size_t v) {
+  while ((*parent)[v] != v) {
+    (*parent)[v] = (*parent)[(*parent)[v]];
+    v = (*parent)[v];
+  }
+  return v;
+}
+
+// The same on a union-find shared between threads. Parents only ever move
+// to smaller ids, so concurrent halving and linking cannot make a cycle.
+std::size_t FindRoot(std::vector<std::atomic<std::size_t>>* parent,
+                     std::size_t v) {
+  for (;;) {
+    std::size_t p = (*parent)[v].load(std::memory_order_relaxed);
+    if (p == v) return v;
+    std::size_t const grandparent =
+        (*parent)[p].load(std::memory_order_relaxed);
+    if (grandparent != p) {
+      (*parent)[v].compare_exchange_weak(p, grandparent,
+                                         std::memory_order_relaxed);
+    }
+    v = grandparent;
+  }
+}
+
+// Merges the trees of u and v, hooking the larger root under the smaller
+// one; a failed swap means another thread moved the root, so retry.
+void LinkRoots(std::vector<std::atomic<std::size_t>>* parent, std::size_t u,
+               std::size_t v) {
+  for (;;) {
+    u = FindRoot(parent, u);
+    v = FindRoot(parent, v);
+    if (u == v) return;
+    if (u < v) std::swap(u, v);
+    std::size_t expected = u;
+    if ((*parent)[u].compare_exchange_strong(expected, v,
+                                             std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+// Appends the path through the arc joining two search trees, as vertices
+// numbered from 1: the parent chain of meeting.first in the forward tree
+// from its root, then that of meeting.second in the backward tree up to
+// its root. Roots are their own parents; a single tree is given as
+// (v, v) and the trees may share a workspace.
+template <typename W>
+void TracePath(const BasicGraph<W>& graph,
+               const BasicSearchWorkspace<W>& forward,
+               const BasicSearchWorkspace<W>& backward,
+               std::pair<std::size_t, std::size_t> meeting,
+               std::vector<int>* path) {
+  auto const id = [&graph](std::size_t v) {
+    return (int)graph.ToOriginalId(v) + 1;
+  };
+  std::size_t const begin = path->size();
+  for (std::size_t v = meeting.first;; v = forward.Parent(v)) {
+    path->push_back(id(v));
+    if (forward.Parent(v) == v) break;
+  }
+  std::reverse(path->begin() + (std::ptrdiff_t)begin, path->end());
+  if (meeting.second == meeting.first) return;
+  for (std::size_t v = meeting.second;; v = backward.Parent(v)) {
+    path->push_back(id(v));
+    if (backward.Parent(v) == v) break;
+  }
+}
+
+// Dijkstra from source on storage ids with an indexed heap: settled
+// vertices are visited, reached ones not yet settled are in the heap with
+// their tentative distance, which decrease-key lowers in place. Parents
+// record the tree. Stops once target is settled and returns whether it
+// was; a target of the number of vertices settles everything reachable.
+// Vertices leave the heap by distance plus potential(vertex): with a
+// potential that never drops by more than the weight of an arc and is 0
+// at the target this is A*, still settling every vertex at its distance.
+template <typename W, typename Potential>
+bool RunDijkstra(const BasicCsrMatrix<W>& adjacency, std::size_t source,
+                 std::size_t target, BasicSearchWorkspace<W>* workspace,
+                 Potential&& potential) {
+  using distance_type = typename BasicGraph<W>::distance_type;
+  workspace->Reset(adjacency.GetRows());
+  IndexedHeap<distance_type>& heap = workspace->Heap();
+  workspace->SetDistance(source, 0);
+  workspace->SetParent(source, source);
+  heap.Push(source, potential(source));
+
+  while (!heap.Empty()) {
+    std::size_t const vertex = heap.Top().second;
+    heap.Pop();
+    workspace->Visit(vertex);
+    if (vertex == target) return true;
+
+    distance_type const distance = workspace->Distance(vertex);
+    adjacency.ForEachInRow(vertex, [&](std::size_t i, W weight) {
+      if (workspace->IsVisited(i)) return;
+      distance_type const length = distance + weight;
+      if (!workspace->IsReached(i)) {
+        heap.Push(i, length + potential(i));
+      } else if (length < workspace->Distance(i)) {
+        heap.DecreaseKey(i, length + potential(i));
+      } else {
+        return;
+      }
+      workspace->SetDistance(i, length);
+      workspace->SetParent(i, vertex);
+    });
+  }
+  return false;
+}
+
+template <typename W>
+bool RunDijkstra(const BasicGraph<W>& graph, std::size_t source,
+                 std::size_t target, BasicSearchWorkspace<W>* workspace) {
+  auto const adjacency = graph.Csr();
+  return RunDijkstra(*adjacency, source, target, workspace,
+                     [](std::size_t) {
+                       return typename BasicGraph<W>::distance_type(0);
+                     });
+}
+
+// Dijkstra from source on storage ids over a monotone queue with integer
+// keys, see GraphAlgoritms::PriorityQueue. A vertex is pushed again when
+// its distance drops and settled by the first of its entries to be
+// popped, the later ones being stale. Otherwise like RunDijkstra.
+template <typename W, typename Queue>
+bool RunMonotoneDijkstra(const BasicGraph<W>& graph, std::size_t source,
+                         std::size_t target,
+                         BasicSearchWorkspace<W>* workspace, Queue* queue) {
+  using distance_type = typename BasicGraph<W>::distance_type;
+  auto const adjacency = graph.Csr();
+  workspace->Reset(graph.AmountOfVertices());
+  workspace->SetDistance(source, 0);
+  workspace->SetParent(source, source);
+  queue->Push(0, source);
+
+  while (!queue->Empty()) {
+    std::size_t const vertex = queue->Pop().second;
+    if (workspace->IsVisited(vertex)) continue;
+    workspace->Visit(vertex);
+    if (vertex == target) return true;
+
+    distance_type const distance = workspace->Distance(vertex);
+    adjacency->ForEachInRow(vertex, [&](std::size_t i, W weight) {
+      if (workspace->IsVisited(i)) return;
+      distance_type const length = distance + weight;
+      if (workspace->IsReached(i) && !(length < workspace->Distance(i))) {
+        return;
+      }
+      workspace->SetDistance(i, length);
+      workspace->SetParent(i, vertex);
+      queue->Push(static_cast<std::uint64_t>(length), i);
+    });
+  }
+  return false;
+}
+
+// Lowers *value to candidate if that is smaller; returns whether it did.
+template <typename W>
+bool AtomicMin(std::atomic<W>* value, W candidate) {
+  W current = value->load(std::memory_order_relaxed);
+  while (candidate < current) {
+    if (value->compare_exchange_weak(current, candidate,
+                                     std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The length of a path as a weight, for the functions returning W.
+template <typename W, typename Distance>
+W NarrowDistance(Distance distance) {
+  if (distance > static_cast<Distance>(std::numeric_limits<W>::max()) ||
+      distance < static_cast<Distance>(std::numeric_limits<W>::lowest())) {
+    throw std::overflow_error("the distance does not fit the weight type");
+  }
+  return static_cast<W>(distance);
+}
+
+// Collects the vertices in the order the search examines them.
+template <typename W>
+struct OrderRecorder : BasicSearchVisitor<W> {
+  std::vector<int>* order;
+
+  bool ExamineVertex(int vertex) {
+    order->push_back(vertex);
+    return true;
+  }
+};
+
+// Stops the search once it reaches the target.
+template <typename W>
+struct TargetFinder : BasicSearchVisitor<W> {
+  int target;
+
+  bool DiscoverVertex(int vertex) { return vertex != target; }
+};
+
+// Builds the tree from the search state in storage ids: the vertices in
+// visiting order and their parents and levels.
+template <typename W>
+GraphAlgoritms::BfsTree MakeBfsTree(const BasicGraph<W>& graph,
+                                    const std::vector<std::size_t>& order,
+                                    const std::vector<int>& parent,
+                                    const std::vector<int>& level) {
+  GraphAlgoritms::BfsTree tree;
+  tree.parent.assign(graph.AmountOfVertices(), -1);
+  tree.level.assign(graph.AmountOfVertices(), -1);
+  tree.visited.reserve(order.size());
+  for (std::size_t v : order) {
+    std::size_t const original = graph.ToOriginalId(v);
+    tree.visited.push_back((int)original + 1);
+    tree.parent[original] =
+        (int)graph.ToOriginalId((std::size_t)parent[v]) + 1;
+    tree.level[original] = level[v];
+  }
+  return tree;
+}
+
+}  // namespace
+
+tsm::TsmResult GraphAlgoritms::SolveTravelingSalesmanProblem(
+    const Graph& graph) {
   tsm::AntColony ac;
   return ac.FindOptimalPath(graph);
 }
 
 tsm::TsmResult GraphAlgoritms::NaiveSolveTravelingSalesmanProblem(
-    Graph& graph) {
+    const Graph& graph) {
   size_t number_of_cities = graph.AmountOfVertices();
 
   tsm::TsmResult best_result;
@@ -36,11 +385,14 @@ tsm::TsmResult GraphAlgoritms::NaiveSolveTravelingSalesmanProblem(
 }
 
 tsm::TsmResult GraphAlgoritms::NearestNeighborSolveTravelingSalesmanProblem(
-    Graph& graph) {
+    const Graph& graph) {
   tsm::TsmResult best_result;
   best_result.distance = INFINITY;
 
   size_t number_of_cities = graph.AmountOfVertices();
+  // Neighbours by increasing distance: the nearest unvisited city is the
+  // first unvisited one in the list.
+  auto const by_weight = graph.NeighborsByWeight();
 
   for (size_t city_from = 0; city_from < number_of_cities; city_from++) {
     int current_city = (int)city_from;
@@ -53,14 +405,19 @@ tsm::TsmResult GraphAlgoritms::NearestNeighborSolveTravelingSalesmanProblem(
     visited[current_city] = true;
 
     for (size_t j = 1; j < number_of_cities; j++) {
-      int nearestness = __INT_MAX__;
       int nearest = -1;
+      int nearest_weight = 0;
 
-      for (size_t k = 0; k < number_of_cities; k++) {
-        if (graph(current_city, k) < nearestness &&
-            graph(current_city, k) != 0 && !visited[k]) {
-          nearestness = graph(current_city, k);
-          nearest = (int)k;
+      // Ties go to the smallest original id, whatever the storage order.
+      std::size_t const from = graph.ToStorageId((std::size_t)current_city);
+      for (std::size_t k = by_weight->offsets[from];
+           k < by_weight->offsets[from + 1]; k++) {
+        std::size_t const to = graph.ToOriginalId(by_weight->targets[k]);
+        if (visited[to]) continue;
+        if (nearest != -1 && by_weight->weights[k] != nearest_weight) break;
+        if (nearest == -1 || (int)to < nearest) {
+          nearest = (int)to;
+          nearest_weight = by_weight->weights[k];
         }
       }
 
@@ -84,153 +441,1103 @@ tsm::TsmResult GraphAlgoritms::NearestNeighborSolveTravelingSalesmanProblem(
   return best_result;
 }
 
-std::vector<int> GraphAlgoritms::depthFirstSearch(Graph& graph,
+template <typename W>
+std::vector<int> GraphAlgoritms::depthFirstSearch(const BasicGraph<W>& graph,
                                                   int startVertex) {
-  std::vector<int> result(0);
-  s21::stack<int> vertices;
-  std::vector<bool> vertices_used(graph.AmountOfVertices(), false);
+  std::vector<int> result;
+  depthFirstSearch(graph, startVertex,
+                   &BasicSearchWorkspace<W>::ForThisThread(), &result);
+  return result;
+}
 
-  vertices.push(startVertex);
-  vertices_used[startVertex - 1] = 1;
+template <typename W>
+void GraphAlgoritms::depthFirstSearch(const BasicGraph<W>& graph,
+                                      int startVertex,
+                                      BasicSearchWorkspace<W>* workspace,
+                                      std::vector<int>* result) {
+  result->clear();
+  depthFirstVisit(graph, startVertex, OrderRecorder<W>{{}, result}, workspace);
+}
 
-  while (vertices.empty() == false) {
-    int cur_vertice = vertices.top() - 1;
-    result.push_back(vertices.top());
-    vertices.pop();
+template <typename W>
+std::vector<int> GraphAlgoritms::breadthFirstSearch(const BasicGraph<W>& graph,
+                                                    int startVertex) {
+  std::vector<int> result;
+  breadthFirstSearch(graph, startVertex,
+                     &BasicSearchWorkspace<W>::ForThisThread(), &result);
+  return result;
+}
+
+template <typename W>
+void GraphAlgoritms::breadthFirstSearch(const BasicGraph<W>& graph,
+                                        int startVertex,
+                                        BasicSearchWorkspace<W>* workspace,
+                                        std::vector<int>* result) {
+  result->clear();
+  breadthFirstVisit(graph, startVertex, OrderRecorder<W>{{}, result},
+                    workspace);
+}
+
+template <typename W>
+bool GraphAlgoritms::isReachable(const BasicGraph<W>& graph, int vertex1,
+                                 int vertex2) {
+  CheckStartVertex(graph.AmountOfVertices(), vertex2);
+  return !breadthFirstVisit(graph, vertex1, TargetFinder<W>{{}, vertex2});
+}
+
+template <typename W>
+GraphAlgoritms::BfsTree GraphAlgoritms::breadthFirstSearchTree(
+    const BasicGraph<W>& graph, int startVertex, BfsMode mode) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  CheckStartVertex(vertices, startVertex);
+  // Beamer's switching thresholds.
+  constexpr std::size_t kAlpha = 14;
+  constexpr std::size_t kBeta = 24;
+  using word_type = BitMatrix::word_type;
+  constexpr std::size_t kWordBits = BitMatrix::kWordBits;
+
+  auto const forward = graph.Csr();
+  auto const backward = graph.ReverseCsr();
+  auto const out_degree = [&forward](std::size_t v) {
+    return forward->RowEnd(v) - forward->RowBegin(v);
+  };
+  auto const in_degree = [&backward](std::size_t v) {
+    return backward->RowEnd(v) - backward->RowBegin(v);
+  };
+
+  // The search runs on storage ids, see BasicGraph::Reorder.
+  std::vector<int> parent(vertices, kUndefined);
+  std::vector<int> level(vertices, kUndefined);
+  std::size_t const start = graph.ToStorageId((std::size_t)startVertex - 1);
+  parent[start] = (int)start;
+  level[start] = 0;
+  std::vector<std::size_t> order(1, start);
+  std::vector<word_type> in_frontier((vertices + kWordBits - 1) / kWordBits);
+  std::size_t frontier_arcs = out_degree(start);
+  std::size_t unexplored_arcs = backward->GetNonZeros() - in_degree(start);
+  bool bottom_up = mode == BfsMode::kBottomUp;
 
-    for (size_t i = 0; i < graph.AmountOfVertices(); i++) {
-      if (graph(cur_vertice, i) != 0 && vertices_used[i] == false) {
-        vertices.push((int)i + 1);
-        vertices_used[i] = true;
+  // The frontier is order[begin, end).
+  for (std::size_t begin = 0, end = 1; begin < end;
+       begin = end, end = order.size()) {
+    int const depth = level[order[begin]] + 1;
+    if (mode == BfsMode::kDirectionOptimizing) {
+      if (!bottom_up && frontier_arcs > unexplored_arcs / kAlpha) {
+        bottom_up = true;
+      } else if (bottom_up && end - begin < vertices / kBeta) {
+        bottom_up = false;
       }
     }
+
+    if (bottom_up) {
+      std::fill(in_frontier.begin(), in_frontier.end(), word_type(0));
+      for (std::size_t k = begin; k < end; k++) {
+        in_frontier[order[k] / kWordBits] |= word_type(1)
+                                             << (order[k] % kWordBits);
+      }
+      const auto* sources = backward->Columns();
+      for (std::size_t v = 0; v < vertices; v++) {
+        if (level[v] != kUndefined) continue;
+        for (std::size_t k = backward->RowBegin(v); k < backward->RowEnd(v);
+             k++) {
+          std::size_t const u = sources[k];
+          if ((in_frontier[u / kWordBits] >> (u % kWordBits)) & 1) {
+            parent[v] = (int)u;
+            level[v] = depth;
+            order.push_back(v);
+            break;
+          }
+        }
+      }
+    } else {
+      for (std::size_t k = begin; k < end; k++) {
+        std::size_t const u = order[k];
+        forward->ForEachInRow(u, [&](std::size_t v, W) {
+          if (level[v] == kUndefined) {
+            parent[v] = (int)u;
+            level[v] = depth;
+            order.push_back(v);
+          }
+        });
+      }
+    }
+
+    frontier_arcs = 0;
+    for (std::size_t k = end; k < order.size(); k++) {
+      frontier_arcs += out_degree(order[k]);
+      unexplored_arcs -= in_degree(order[k]);
+    }
   }
 
-  return result;
+  return MakeBfsTree(graph, order, parent, level);
 }
-std::vector<int> GraphAlgoritms::breadthFirstSearch(Graph& graph,
-                                                    int startVertex) {
-  std::vector<int> result(0);
-  s21::queue<int> vertices;
-  std::vector<bool> vertices_used(graph.AmountOfVertices(), false);
 
-  vertices.push(startVertex);
-  vertices_used[startVertex - 1] = 1;
+template <typename W>
+Matrix GraphAlgoritms::multiSourceBreadthFirstSearch(
+    const BasicGraph<W>& graph, const std::vector<int>& sources) {
+  using mask_type = BitMatrix::word_type;
+  constexpr std::size_t kBatch = BitMatrix::kWordBits;
+  std::size_t const vertices = graph.AmountOfVertices();
+  for (int source : sources) CheckStartVertex(vertices, source);
+  if (sources.empty()) return Matrix();
 
-  while (vertices.empty() == false) {
-    int cur_vertice = vertices.front() - 1;
-    result.push_back(vertices.front());
-    vertices.pop();
+  auto const adjacency = graph.Csr();
+  Matrix distances(sources.size(), vertices);
+  for (std::size_t s = 0; s < sources.size(); s++) {
+    std::fill(distances.Row(s), distances.Row(s) + vertices, kUndefined);
+  }
+  // seen[v] has bit b set once source first + b has reached v, visit[v]
+  // once it has reached v in the last level.
+  std::vector<mask_type> seen(vertices), visit(vertices), next(vertices);
 
-    for (size_t i = 0; i < graph.AmountOfVertices(); i++) {
-      if (graph(cur_vertice, i) != 0 && vertices_used[i] == false) {
-        vertices.push((int)i + 1);
-        vertices_used[i] = true;
+  for (std::size_t first = 0; first < sources.size(); first += kBatch) {
+    std::size_t const batch = std::min(kBatch, sources.size() - first);
+    std::fill(seen.begin(), seen.end(), mask_type(0));
+    std::fill(visit.begin(), visit.end(), mask_type(0));
+    for (std::size_t b = 0; b < batch; b++) {
+      std::size_t const v =
+          graph.ToStorageId((std::size_t)sources[first + b] - 1);
+      seen[v] |= mask_type(1) << b;
+      visit[v] |= mask_type(1) << b;
+      distances(first + b, (std::size_t)sources[first + b] - 1) = 0;
+    }
+
+    for (int level = 1;; level++) {
+      std::fill(next.begin(), next.end(), mask_type(0));
+      for (std::size_t v = 0; v < vertices; v++) {
+        if (visit[v] == 0) continue;
+        adjacency->ForEachInRow(
+            v, [&next, &visit, v](std::size_t u, W) { next[u] |= visit[v]; });
+      }
+      bool reached = false;
+      for (std::size_t u = 0; u < vertices; u++) {
+        mask_type fresh = next[u] & ~seen[u];
+        next[u] = fresh;
+        if (fresh == 0) continue;
+        reached = true;
+        seen[u] |= fresh;
+        std::size_t const original = graph.ToOriginalId(u);
+        for (; fresh != 0; fresh &= fresh - 1) {
+          std::size_t const b = (std::size_t)BitMatrix::LowestBit(fresh);
+          distances(first + b, original) = level;
+        }
       }
+      if (!reached) break;
+      visit.swap(next);
     }
   }
+  return distances;
+}
 
-  return result;
+template <typename W>
+GraphAlgoritms::BfsTree GraphAlgoritms::parallelBreadthFirstSearch(
+    const BasicGraph<W>& graph, int startVertex, unsigned threads) {
+  ThreadPool pool(threads);
+  return parallelBreadthFirstSearch(graph, startVertex, &pool);
 }
 
-int GraphAlgoritms::getShortestPathBetweenVertices(Graph& graph, int vertex1,
-                                                   int vertex2) {
-  std::vector<int> shotrestPathsToVert(graph.AmountOfVertices(), kUndefined);
-  std::vector<bool> verticeVisited(graph.AmountOfVertices(), false);
+template <typename W>
+GraphAlgoritms::BfsTree GraphAlgoritms::parallelBreadthFirstSearch(
+    const BasicGraph<W>& graph, int startVertex, ThreadPool* pool) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  CheckStartVertex(vertices, startVertex);
+  // Frontier vertices are handed out in chunks of this many; smaller
+  // frontiers are expanded by the calling thread alone.
+  constexpr std::size_t kChunk = 256;
 
-  int curVertex = vertex1 - 1;
-  shotrestPathsToVert[curVertex] = 0;
+  auto const adjacency = graph.Csr();
+  // A vertex belongs to the worker that swaps its parent from kUndefined.
+  std::vector<std::atomic<int>> parent(vertices);
+  for (std::atomic<int>& p : parent) {
+    p.store(kUndefined, std::memory_order_relaxed);
+  }
+  std::vector<int> level(vertices, kUndefined);
+  std::size_t const start = graph.ToStorageId((std::size_t)startVertex - 1);
+  parent[start].store((int)start, std::memory_order_relaxed);
+  level[start] = 0;
 
-  while (curVertex != kUndefined && curVertex != vertex2 - 1) {
-    verticeVisited[curVertex] = true;
-    for (size_t i = 0; i < graph.AmountOfVertices(); i++) {
-      if (verticeVisited[i] == true || graph(curVertex, i) == 0) {
-        continue;
+  std::vector<std::size_t> order(1, start);
+  std::vector<std::vector<std::size_t>> found(pool->GetThreads());
+  std::vector<std::size_t> offsets(pool->GetThreads() + 1);
+  std::atomic<std::size_t> cursor(0);
+
+  for (std::size_t begin = 0, end = 1; begin < end;
+       begin = end, end = order.size()) {
+    int const depth = level[order[begin]] + 1;
+    cursor.store(begin, std::memory_order_relaxed);
+    auto const expand = [&](unsigned t) {
+      std::vector<std::size_t>& next = found[t];
+      next.clear();
+      for (;;) {
+        std::size_t const first =
+            cursor.fetch_add(kChunk, std::memory_order_relaxed);
+        if (first >= end) break;
+        for (std::size_t k = first; k < std::min(first + kChunk, end); k++) {
+          std::size_t const u = order[k];
+          adjacency->ForEachInRow(u, [&](std::size_t v, W) {
+            if (parent[v].load(std::memory_order_relaxed) != kUndefined) {
+              return;
+            }
+            int expected = kUndefined;
+            if (parent[v].compare_exchange_strong(
+                    expected, (int)u, std::memory_order_relaxed)) {
+              level[v] = depth;
+              next.push_back(v);
+            }
+          });
+        }
       }
+    };
+    unsigned const workers = end - begin > kChunk ? pool->GetThreads() : 1;
+    if (workers == 1) {
+      expand(0);
+    } else {
+      pool->Run(expand);
+    }
 
-      int newPathLen = shotrestPathsToVert[curVertex] + graph(curVertex, i);
+    // Every worker copies its buffer to its own range of the frontier.
+    for (unsigned t = 0; t < workers; t++) {
+      offsets[t + 1] = offsets[t] + found[t].size();
+    }
+    order.resize(end + offsets[workers]);
+    auto const merge = [&](unsigned t) {
+      std::copy(found[t].begin(), found[t].end(),
+                order.begin() + (std::ptrdiff_t)(end + offsets[t]));
+    };
+    if (workers == 1) {
+      merge(0);
+    } else {
+      pool->Run(merge);
+    }
+  }
 
-      if (shotrestPathsToVert[i] == kUndefined) {
-        shotrestPathsToVert[i] = newPathLen;
-      } else {
-        shotrestPathsToVert[i] = std::min(shotrestPathsToVert[i], newPathLen);
+  std::vector<int> parents(vertices);
+  for (std::size_t v = 0; v < vertices; v++) {
+    parents[v] = parent[v].load(std::memory_order_relaxed);
+  }
+  return MakeBfsTree(graph, order, parents, level);
+}
+
+template <typename W>
+GraphAlgoritms::Components GraphAlgoritms::weaklyConnectedComponents(
+    const BasicGraph<W>& graph) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  auto const adjacency = graph.Csr();
+  std::vector<std::size_t> parent(vertices);
+  std::vector<std::size_t> size(vertices, 1);
+  for (std::size_t v = 0; v < vertices; v++) parent[v] = v;
+
+  for (std::size_t u = 0; u < vertices; u++) {
+    adjacency->ForEachInRow(u, [&](std::size_t v, W) {
+      std::size_t a = FindRoot(&parent, u);
+      std::size_t b = FindRoot(&parent, v);
+      if (a == b) return;
+      // Union by size: with path halving this is O(α(V)) per arc.
+      if (size[a] < size[b]) std::swap(a, b);
+      parent[b] = a;
+      size[a] += size[b];
+    });
+  }
+  std::vector<std::size_t> root(vertices);
+  for (std::size_t v = 0; v < vertices; v++) root[v] = FindRoot(&parent, v);
+  return NumberComponents(graph, root);
+}
+
+template <typename W>
+GraphAlgoritms::Components GraphAlgoritms::parallelWeaklyConnectedComponents(
+    const BasicGraph<W>& graph, unsigned threads) {
+  ThreadPool pool(threads);
+  return parallelWeaklyConnectedComponents(graph, &pool);
+}
+
+template <typename W>
+GraphAlgoritms::Components GraphAlgoritms::parallelWeaklyConnectedComponents(
+    const BasicGraph<W>& graph, ThreadPool* pool) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  // Vertices are handed out in chunks of this many.
+  constexpr std::size_t kChunk = 256;
+
+  auto const adjacency = graph.Csr();
+  std::vector<std::atomic<std::size_t>> parent(vertices);
+  for (std::size_t v = 0; v < vertices; v++) {
+    parent[v].store(v, std::memory_order_relaxed);
+  }
+  std::atomic<std::size_t> cursor(0);
+  pool->Run([&](unsigned) {
+    for (;;) {
+      std::size_t const first =
+          cursor.fetch_add(kChunk, std::memory_order_relaxed);
+      if (first >= vertices) break;
+      for (std::size_t u = first; u < std::min(first + kChunk, vertices);
+           u++) {
+        adjacency->ForEachInRow(
+            u, [&](std::size_t v, W) { LinkRoots(&parent, u, v); });
       }
     }
-    curVertex = kUndefined;
-    for (size_t i = 0; i < graph.AmountOfVertices(); i++) {
-      if (verticeVisited[i] == true || shotrestPathsToVert[i] == kUndefined) {
+  });
+
+  std::vector<std::size_t> label(vertices);
+  for (std::size_t v = 0; v < vertices; v++) {
+    label[v] = FindRoot(&parent, v);
+  }
+  return NumberComponents(graph, label);
+}
+
+template <typename W>
+GraphAlgoritms::Components GraphAlgoritms::stronglyConnectedComponents(
+    const BasicGraph<W>& graph) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  std::size_t const unvisited = vertices;
+  auto const adjacency = graph.Csr();
+  const auto* columns = adjacency->Columns();
+
+  // index is the discovery number, low the smallest one reachable through
+  // the subtree and a back arc; label holds the root of a finished
+  // component and unvisited while the vertex is on the stack.
+  std::vector<std::size_t> index(vertices, unvisited);
+  std::vector<std::size_t> low(vertices);
+  std::vector<std::size_t> label(vertices, unvisited);
+  std::vector<std::size_t> stack;
+  // The recursion: a vertex and the next of its arcs to follow.
+  std::vector<std::pair<std::size_t, std::size_t>> calls;
+  std::size_t counter = 0;
+
+  for (std::size_t root = 0; root < vertices; root++) {
+    if (index[root] != unvisited) continue;
+    index[root] = low[root] = counter++;
+    stack.push_back(root);
+    calls.emplace_back(root, adjacency->RowBegin(root));
+
+    while (!calls.empty()) {
+      auto& [v, arc] = calls.back();
+      if (arc < adjacency->RowEnd(v)) {
+        std::size_t const w = columns[arc++];
+        if (index[w] == unvisited) {
+          index[w] = low[w] = counter++;
+          stack.push_back(w);
+          calls.emplace_back(w, adjacency->RowBegin(w));
+        } else if (label[w] == unvisited) {
+          low[v] = std::min(low[v], index[w]);
+        }
         continue;
       }
-      if (curVertex == kUndefined ||
-          shotrestPathsToVert[i] < shotrestPathsToVert[curVertex]) {
-        curVertex = (int)i;
+
+      std::size_t const done = v;
+      calls.pop_back();
+      if (low[done] == index[done]) {
+        std::size_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          label[w] = done;
+        } while (w != done);
+      }
+      if (!calls.empty()) {
+        std::size_t const caller = calls.back().first;
+        low[caller] = std::min(low[caller], low[done]);
       }
     }
   }
+  return NumberComponents(graph, label);
+}
 
-  return shotrestPathsToVert[vertex2 - 1];
+std::vector<int> GraphAlgoritms::depthFirstSearch(const BitMatrix& adjacency,
+                                                  int startVertex) {
+  CheckAdjacency(adjacency, startVertex);
+  std::vector<int> result;
+  std::vector<int> vertices(1, startVertex);
+  std::vector<BitMatrix::word_type> visited(adjacency.GetWordsPerRow(), 0);
+  visited[(startVertex - 1) / BitMatrix::kWordBits] |=
+      BitMatrix::word_type(1) << ((startVertex - 1) % BitMatrix::kWordBits);
+
+  while (vertices.empty() == false) {
+    int const cur_vertice = vertices.back();
+    vertices.pop_back();
+    result.push_back(cur_vertice);
+    TakeUnvisitedNeighbors(adjacency, (std::size_t)cur_vertice - 1, &visited,
+                           &vertices);
+  }
+
+  return result;
 }
 
-Matrix GraphAlgoritms::getShortestPathsBetweenAllVertices(Graph& graph) {
-  Matrix result(graph.AmountOfVertices(), graph.AmountOfVertices());
+std::vector<int> GraphAlgoritms::breadthFirstSearch(const BitMatrix& adjacency,
+                                                    int startVertex) {
+  CheckAdjacency(adjacency, startVertex);
+  // Every vertex is queued once, so the result doubles as the queue.
+  std::vector<int> result(1, startVertex);
+  std::vector<BitMatrix::word_type> visited(adjacency.GetWordsPerRow(), 0);
+  visited[(startVertex - 1) / BitMatrix::kWordBits] |=
+      BitMatrix::word_type(1) << ((startVertex - 1) % BitMatrix::kWordBits);
 
-  for (size_t i = 0; i < graph.AmountOfVertices(); i++) {
-    for (size_t j = 0; j < graph.AmountOfVertices(); j++) {
-      if (graph(i, j) == 0 && i != j) {
-        result(i, j) = kUndefined;
-      } else {
-        result(i, j) = graph(i, j);
+  for (std::size_t head = 0; head < result.size(); head++) {
+    TakeUnvisitedNeighbors(adjacency, (std::size_t)result[head] - 1, &visited,
+                           &result);
+  }
+
+  return result;
+}
+
+template <typename W>
+GraphAlgoritms::HopPath GraphAlgoritms::bidirectionalBreadthFirstSearch(
+    const BasicGraph<W>& graph, int vertex1, int vertex2) {
+  return bidirectionalBreadthFirstSearch(
+      graph, vertex1, vertex2, &BasicSearchWorkspace<W>::ForThisThread());
+}
+
+template <typename W>
+GraphAlgoritms::HopPath GraphAlgoritms::bidirectionalBreadthFirstSearch(
+    const BasicGraph<W>& graph, int vertex1, int vertex2,
+    BasicSearchWorkspace<W>* workspace) {
+  CheckStartVertex(graph.AmountOfVertices(), vertex1);
+  CheckStartVertex(graph.AmountOfVertices(), vertex2);
+  std::size_t const source = graph.ToStorageId((std::size_t)vertex1 - 1);
+  std::size_t const target = graph.ToStorageId((std::size_t)vertex2 - 1);
+  std::pair<std::size_t, std::size_t> meeting;
+  HopPath path;
+  path.hops = MeetInTheMiddle(graph, source, target, workspace, &meeting);
+  if (path.hops == kUndefined) return path;
+
+  path.vertices.reserve((std::size_t)path.hops + 1);
+  TracePath(graph, *workspace, *workspace, meeting, &path.vertices);
+  return path;
+}
+
+template <typename W>
+W GraphAlgoritms::getShortestPathBetweenVertices(const BasicGraph<W>& graph,
+                                                 int vertex1, int vertex2) {
+  return getShortestPathBetweenVertices(
+      graph, vertex1, vertex2, &BasicSearchWorkspace<W>::ForThisThread());
+}
+
+template <typename W>
+W GraphAlgoritms::getShortestPathBetweenVertices(
+    const BasicGraph<W>& graph, int vertex1, int vertex2,
+    BasicSearchWorkspace<W>* workspace) {
+  CheckStartVertex(graph.AmountOfVertices(), vertex1);
+  CheckStartVertex(graph.AmountOfVertices(), vertex2);
+  W const undefined = static_cast<W>(kUndefined);
+  std::size_t const source = graph.ToStorageId((std::size_t)vertex1 - 1);
+  std::size_t const target = graph.ToStorageId((std::size_t)vertex2 - 1);
+
+  if (graph.HasUniformWeights()) {
+    // Every arc costs the same: the path with the fewest arcs is the
+    // shortest one, and bidirectional BFS finds it.
+    std::pair<std::size_t, std::size_t> meeting;
+    int const hops = MeetInTheMiddle(graph, source, target, workspace,
+                                     &meeting);
+    using distance_type = typename BasicGraph<W>::distance_type;
+    return hops == kUndefined
+               ? undefined
+               : NarrowDistance<W>(static_cast<distance_type>(hops) *
+                                   graph.MaxWeight());
+  }
+
+  return RunDijkstra(graph, source, target, workspace)
+             ? NarrowDistance<W>(workspace->Distance(target))
+             : undefined;
+}
+
+template <typename W>
+W GraphAlgoritms::getShortestPathBetweenVertices(
+    const BasicGraph<W>& graph, int vertex1, int vertex2, PriorityQueue queue,
+    BasicSearchWorkspace<W>* workspace) {
+  CheckStartVertex(graph.AmountOfVertices(), vertex1);
+  CheckStartVertex(graph.AmountOfVertices(), vertex2);
+  if (workspace == nullptr) {
+    workspace = &BasicSearchWorkspace<W>::ForThisThread();
+  }
+  if (queue != PriorityQueue::kHeap &&
+      (!std::is_integral<W>::value || graph.MinWeight() < 0)) {
+    throw std::invalid_argument(
+        "bucket queues need non-negative integer weights");
+  }
+  std::size_t const source = graph.ToStorageId((std::size_t)vertex1 - 1);
+  std::size_t const target = graph.ToStorageId((std::size_t)vertex2 - 1);
+
+  bool reached = false;
+  switch (queue) {
+    case PriorityQueue::kHeap:
+      reached = RunDijkstra(graph, source, target, workspace);
+      break;
+    case PriorityQueue::kDial:
+      if (static_cast<std::uint64_t>(graph.MaxWeight()) <=
+          BucketQueue::kMaxStep) {
+        workspace->Buckets().Reset(
+            static_cast<std::uint64_t>(graph.MaxWeight()));
+        reached = RunMonotoneDijkstra(graph, source, target, workspace,
+                                      &workspace->Buckets());
+        break;
+      }
+      // The ring would not fit: the radix heap takes any weights.
+      [[fallthrough]];
+    case PriorityQueue::kRadixHeap:
+      workspace->Radix().Reset();
+      reached = RunMonotoneDijkstra(graph, source, target, workspace,
+                                    &workspace->Radix());
+      break;
+  }
+  return reached ? NarrowDistance<W>(workspace->Distance(target))
+                 : static_cast<W>(kUndefined);
+}
+
+template <typename W>
+GraphAlgoritms::ShortestPath<W> GraphAlgoritms::getShortestPath(
+    const BasicGraph<W>& graph, int vertex1, int vertex2) {
+  return getShortestPath(graph, vertex1, vertex2,
+                         &BasicSearchWorkspace<W>::ForThisThread());
+}
+
+template <typename W>
+GraphAlgoritms::ShortestPath<W> GraphAlgoritms::getShortestPath(
+    const BasicGraph<W>& graph, int vertex1, int vertex2,
+    BasicSearchWorkspace<W>* workspace) {
+  CheckStartVertex(graph.AmountOfVertices(), vertex1);
+  CheckStartVertex(graph.AmountOfVertices(), vertex2);
+  std::size_t const source = graph.ToStorageId((std::size_t)vertex1 - 1);
+  std::size_t const target = graph.ToStorageId((std::size_t)vertex2 - 1);
+  ShortestPath<W> path;
+
+  if (graph.HasUniformWeights()) {
+    std::pair<std::size_t, std::size_t> meeting;
+    int const hops = MeetInTheMiddle(graph, source, target, workspace,
+                                     &meeting);
+    if (hops == kUndefined) return path;
+    path.distance =
+        static_cast<decltype(path.distance)>(hops) * graph.MaxWeight();
+    TracePath(graph, *workspace, *workspace, meeting, &path.vertices);
+    return path;
+  }
+
+  if (!RunDijkstra(graph, source, target, workspace)) return path;
+  path.distance = workspace->Distance(target);
+  TracePath(graph, *workspace, *workspace, std::make_pair(target, target),
+            &path.vertices);
+  return path;
+}
+
+template <typename W>
+GraphAlgoritms::ShortestPath<W> GraphAlgoritms::bidirectionalShortestPath(
+    const BasicGraph<W>& graph, int vertex1, int vertex2) {
+  return bidirectionalShortestPath(graph, vertex1, vertex2,
+                                   &BasicSearchWorkspace<W>::ForThisThread());
+}
+
+template <typename W>
+GraphAlgoritms::ShortestPath<W> GraphAlgoritms::bidirectionalShortestPath(
+    const BasicGraph<W>& graph, int vertex1, int vertex2,
+    BasicSearchWorkspace<W>* workspace) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  CheckStartVertex(vertices, vertex1);
+  CheckStartVertex(vertices, vertex2);
+  std::size_t const source = graph.ToStorageId((std::size_t)vertex1 - 1);
+  std::size_t const target = graph.ToStorageId((std::size_t)vertex2 - 1);
+  ShortestPath<W> path;
+  if (source == target) {
+    path.distance = 0;
+    path.vertices.push_back(vertex1);
+    return path;
+  }
+
+  // One side per direction: the forward search from the source over the
+  // arcs, the backward one from the target over the reverse arcs.
+  struct Side {
+    BasicSearchWorkspace<W>* workspace;
+    std::shared_ptr<const typename BasicGraph<W>::csr_type> adjacency;
+  };
+  Side sides[2] = {{workspace, graph.Csr()},
+                   {&workspace->Reverse(), graph.ReverseCsr()}};
+  for (int d = 0; d < 2; d++) {
+    std::size_t const root = d == 0 ? source : target;
+    sides[d].workspace->Reset(vertices);
+    sides[d].workspace->SetDistance(root, 0);
+    sides[d].workspace->SetParent(root, root);
+    sides[d].workspace->Heap().Push(root, 0);
+  }
+
+  // The shortest path seen so far joins the trees through the arc
+  // (meeting.first, meeting.second).
+  using distance_type = typename BasicGraph<W>::distance_type;
+  bool found = false;
+  distance_type best = 0;
+  std::pair<std::size_t, std::size_t> meeting;
+  while (!sides[0].workspace->Heap().Empty() &&
+         !sides[1].workspace->Heap().Empty()) {
+    distance_type const top_forward = sides[0].workspace->Heap().Top().first;
+    distance_type const top_backward = sides[1].workspace->Heap().Top().first;
+    // Every path not seen yet leaves both settled balls, so it is at
+    // least as long as the sum of their radii.
+    if (found && !(top_forward + top_backward < best)) break;
+
+    // Grow the smaller ball.
+    int const d = top_backward < top_forward ? 1 : 0;
+    BasicSearchWorkspace<W>& own = *sides[d].workspace;
+    const BasicSearchWorkspace<W>& other = *sides[1 - d].workspace;
+    auto const [distance, vertex] = own.Heap().Top();
+    own.Heap().Pop();
+    own.Visit(vertex);
+
+    sides[d].adjacency->ForEachInRow(vertex, [&](std::size_t i, W weight) {
+      if (own.IsVisited(i)) return;
+      distance_type const length = distance + weight;
+      if (!own.IsReached(i) || length < own.Distance(i)) {
+        if (own.IsReached(i)) {
+          own.Heap().DecreaseKey(i, length);
+        } else {
+          own.Heap().Push(i, length);
+        }
+        own.SetDistance(i, length);
+        own.SetParent(i, vertex);
+      }
+      if (!other.IsReached(i)) return;
+      distance_type const through = length + other.Distance(i);
+      if (!found || through < best) {
+        found = true;
+        best = through;
+        meeting =
+            d == 0 ? std::make_pair(vertex, i) : std::make_pair(i, vertex);
+      }
+    });
+  }
+
+  if (!found) return path;
+  path.distance = best;
+  TracePath(graph, *sides[0].workspace, *sides[1].workspace, meeting,
+            &path.vertices);
+  return path;
+}
+
+template <typename W>
+BasicLandmarks<W> GraphAlgoritms::selectLandmarks(const BasicGraph<W>& graph,
+                                                  std::size_t count) {
+  using distance_type = typename BasicLandmarks<W>::distance_type;
+  std::size_t const vertices = graph.AmountOfVertices();
+  distance_type const infinity = BasicLandmarks<W>::kInfinity;
+  BasicLandmarks<W> landmarks;
+  landmarks.vertices_ = vertices;
+  landmarks.arcs_ = graph.Csr()->GetNonZeros();
+  landmarks.graph_version_ = graph.Version();
+  landmarks.graph_fingerprint_ = graph.Fingerprint();
+  landmarks.directions_ = graph.IsDirected() ? 2 : 1;
+  count = std::min(count, vertices);
+  landmarks.table_.assign(vertices * count * landmarks.directions_,
+                          infinity);
+
+  auto const arcs = graph.Csr();
+  auto const reverse_arcs = graph.ReverseCsr();
+  BasicSearchWorkspace<W>& workspace = BasicSearchWorkspace<W>::ForThisThread();
+  // Distances of the original vertices from the last search.
+  auto const distance = [&](std::size_t v) {
+    std::size_t const id = graph.ToStorageId(v);
+    return workspace.IsVisited(id) ? workspace.Distance(id) : infinity;
+  };
+  auto const zero = [](std::size_t) { return distance_type(0); };
+
+  // Farthest selection: each landmark is the vertex farthest from the
+  // ones before (from vertex 1 for the first), unreachable counting as
+  // farthest so that every component gets one.
+  std::vector<distance_type> nearest(vertices, infinity);
+  std::vector<bool> chosen(vertices, false);
+  if (count > 0) {
+    RunDijkstra(*arcs, graph.ToStorageId(0), vertices, &workspace, zero);
+    for (std::size_t v = 0; v < vertices; v++) nearest[v] = distance(v);
+  }
+  for (std::size_t l = 0; l < count; l++) {
+    std::size_t landmark = vertices;
+    for (std::size_t v = 0; v < vertices; v++) {
+      if (chosen[v]) continue;
+      if (landmark == vertices || nearest[landmark] < nearest[v]) landmark = v;
+    }
+    chosen[landmark] = true;
+    landmarks.landmarks_.push_back(landmark);
+
+    std::size_t const source = graph.ToStorageId(landmark);
+    RunDijkstra(*arcs, source, vertices, &workspace, zero);
+    for (std::size_t v = 0; v < vertices; v++) {
+      distance_type const d = distance(v);
+      landmarks.table_[(v * count + l) * landmarks.directions_] = d;
+      nearest[v] = std::min(nearest[v], d);
+    }
+    if (landmarks.directions_ == 2) {
+      RunDijkstra(*reverse_arcs, source, vertices, &workspace, zero);
+      for (std::size_t v = 0; v < vertices; v++) {
+        landmarks.table_[(v * count + l) * 2 + 1] = distance(v);
       }
     }
   }
+  return landmarks;
+}
+
+template <typename W>
+GraphAlgoritms::ShortestPath<W> GraphAlgoritms::altShortestPath(
+    const BasicGraph<W>& graph, const BasicLandmarks<W>& landmarks,
+    int vertex1, int vertex2) {
+  return altShortestPath(graph, landmarks, vertex1, vertex2,
+                         &BasicSearchWorkspace<W>::ForThisThread());
+}
+
+template <typename W>
+GraphAlgoritms::ShortestPath<W> GraphAlgoritms::altShortestPath(
+    const BasicGraph<W>& graph, const BasicLandmarks<W>& landmarks,
+    int vertex1, int vertex2, BasicSearchWorkspace<W>* workspace) {
+  CheckStartVertex(graph.AmountOfVertices(), vertex1);
+  CheckStartVertex(graph.AmountOfVertices(), vertex2);
+  if (!landmarks.Fits(graph)) {
+    throw std::invalid_argument("landmarks were made for another graph");
+  }
+  std::size_t const source = graph.ToStorageId((std::size_t)vertex1 - 1);
+  std::size_t const target = graph.ToStorageId((std::size_t)vertex2 - 1);
+  std::size_t const goal = (std::size_t)vertex2 - 1;
+  auto const adjacency = graph.Csr();
+  ShortestPath<W> path;
+  bool const reached = RunDijkstra(
+      *adjacency, source, target, workspace, [&](std::size_t v) {
+        return landmarks.LowerBound(graph.ToOriginalId(v), goal);
+      });
+  if (!reached) return path;
+  path.distance = workspace->Distance(target);
+  TracePath(graph, *workspace, *workspace, std::make_pair(target, target),
+            &path.vertices);
+  return path;
+}
+
+template <typename W>
+std::vector<typename BasicGraph<W>::distance_type>
+GraphAlgoritms::getShortestPathsFromVertex(const BasicGraph<W>& graph,
+                                           int startVertex) {
+  std::size_t const vertices = graph.AmountOfVertices();
+  CheckStartVertex(vertices, startVertex);
+  BasicSearchWorkspace<W>& workspace = BasicSearchWorkspace<W>::ForThisThread();
+  RunDijkstra(graph, graph.ToStorageId((std::size_t)startVertex - 1),
+              vertices, &workspace);
+  using distance_type = typename BasicGraph<W>::distance_type;
+  std::vector<distance_type> distances(vertices,
+                                       static_cast<distance_type>(kUndefined));
+  for (std::size_t v = 0; v < vertices; v++) {
+    std::size_t const id = graph.ToStorageId(v);
+    if (workspace.IsVisited(id)) distances[v] = workspace.Distance(id);
+  }
+  return distances;
+}
+
+template <typename W>
+std::vector<typename BasicGraph<W>::distance_type>
+GraphAlgoritms::deltaSteppingShortestPaths(const BasicGraph<W>& graph,
+                                           int startVertex, unsigned threads,
+                                           W delta) {
+  ThreadPool pool(threads);
+  return deltaSteppingShortestPaths(graph, startVertex, &pool, delta);
+}
+
+template <typename W>
+std::vector<typename BasicGraph<W>::distance_type>
+GraphAlgoritms::deltaSteppingShortestPaths(const BasicGraph<W>& graph,
+                                           int startVertex, ThreadPool* pool,
+                                           W delta) {
+  using distance_type = typename BasicGraph<W>::distance_type;
+  std::size_t const vertices = graph.AmountOfVertices();
+  CheckStartVertex(vertices, startVertex);
+  if (delta < 0 || graph.MinWeight() < 0) {
+    throw std::invalid_argument("delta-stepping needs non-negative weights");
+  }
+  auto const adjacency = graph.Csr();
+  if (delta == 0) {
+    std::size_t const arcs = std::max<std::size_t>(adjacency->GetNonZeros(), 1);
+    double const guess = (double)graph.MaxWeight() * (double)vertices /
+                         (double)arcs;
+    delta = static_cast<W>(
+        std::min(guess, (double)std::numeric_limits<W>::max()));
+    if (!(delta > 0)) delta = static_cast<W>(1);
+  }
+  // Every worker keeps a ring of ceil(MaxWeight() / delta) + 1 buckets, so
+  // a smaller delta is raised to keep it within kMaxSlots; any positive
+  // delta gives the same distances.
+  constexpr double kMaxSlots = 1 << 16;
+  double const max_weight = static_cast<double>(graph.MaxWeight());
+  if (static_cast<double>(delta) * kMaxSlots < max_weight) {
+    delta = static_cast<W>(std::is_integral<W>::value
+                               ? std::ceil(max_weight / kMaxSlots)
+                               : max_weight / kMaxSlots);
+  }
+  // Frontiers are handed out in chunks of this many; smaller ones are
+  // relaxed by the calling thread alone.
+  constexpr std::size_t kChunk = 256;
+  distance_type const infinity = std::numeric_limits<distance_type>::max();
+  auto const bucket_of = [delta](distance_type distance) {
+    return static_cast<std::size_t>(distance / delta);
+  };
 
-  for (size_t k = 0; k < graph.AmountOfVertices(); k++) {
-    for (size_t i = 0; i < graph.AmountOfVertices(); i++) {
-      for (size_t j = 0; j < graph.AmountOfVertices(); j++) {
-        if (result(i, k) != kUndefined && result(k, j) != kUndefined) {
-          if (result(i, j) != kUndefined) {
-            result(i, j) = std::min(result(i, j), result(i, k) + result(k, j));
-          } else {
-            result(i, j) = result(i, k) + result(k, j);
+  // A relaxation from bucket i lands at most ceil(MaxWeight() / delta)
+  // buckets further, so the live buckets fit a ring of one slot more;
+  // floating-point rounding may overshoot by one, which one more covers.
+  double const span = std::ceil(max_weight / static_cast<double>(delta));
+  std::size_t const slots = static_cast<std::size_t>(span) +
+                            (std::is_integral<W>::value ? 1 : 2);
+
+  std::vector<std::atomic<distance_type>> distance(vertices);
+  for (std::atomic<distance_type>& d : distance) {
+    d.store(infinity, std::memory_order_relaxed);
+  }
+  // The bucket each vertex was last settled in, so that one re-entering
+  // its bucket in a later light round has its heavy arcs relaxed once.
+  std::vector<std::atomic<std::size_t>> settled_in(vertices);
+  for (std::atomic<std::size_t>& b : settled_in) {
+    b.store(SIZE_MAX, std::memory_order_relaxed);
+  }
+  // bins[t][i % slots] holds the vertices worker t moved into bucket i,
+  // and settled[t] those whose heavy arcs it has to relax.
+  std::vector<std::vector<std::vector<std::size_t>>> bins(
+      pool->GetThreads(), std::vector<std::vector<std::size_t>>(slots));
+  std::vector<std::vector<std::size_t>> settled(pool->GetThreads());
+  std::vector<std::size_t> frontier;
+  std::atomic<std::size_t> cursor(0);
+
+  std::size_t const start = graph.ToStorageId((std::size_t)startVertex - 1);
+  distance[start].store(0, std::memory_order_relaxed);
+  frontier.push_back(start);
+  std::size_t bucket = 0;
+
+  // Relaxes the light or the heavy arcs of the vertices of items.
+  auto const relax = [&](const std::vector<std::size_t>& items, bool light) {
+    cursor.store(0, std::memory_order_relaxed);
+    auto const work = [&](unsigned t) {
+      for (;;) {
+        std::size_t const first =
+            cursor.fetch_add(kChunk, std::memory_order_relaxed);
+        if (first >= items.size()) break;
+        std::size_t const last = std::min(first + kChunk, items.size());
+        for (std::size_t k = first; k < last; k++) {
+          std::size_t const u = items[k];
+          distance_type const du = distance[u].load(std::memory_order_relaxed);
+          // Entries left behind when the distance dropped are stale.
+          if (light && bucket_of(du) != bucket) continue;
+          if (light && settled_in[u].exchange(
+                           bucket, std::memory_order_relaxed) != bucket) {
+            settled[t].push_back(u);
           }
+          adjacency->ForEachInRow(u, [&](std::size_t v, W weight) {
+            if ((weight <= delta) != light) return;
+            distance_type const dv = du + weight;
+            if (!AtomicMin(&distance[v], dv)) return;
+            bins[t][bucket_of(dv) % slots].push_back(v);
+          });
         }
       }
+    };
+    if (items.size() > kChunk) {
+      pool->Run(work);
+    } else {
+      work(0);
+    }
+  };
+  // Moves the vertices of the bucket from the bins to the frontier.
+  auto const gather = [&] {
+    frontier.clear();
+    for (auto& worker_bins : bins) {
+      std::vector<std::size_t>& bin = worker_bins[bucket % slots];
+      frontier.insert(frontier.end(), bin.begin(), bin.end());
+      bin.clear();
+    }
+  };
+
+  std::vector<std::size_t> heavy;
+  for (;;) {
+    while (!frontier.empty()) {
+      relax(frontier, true);
+      gather();
     }
+    heavy.clear();
+    for (std::vector<std::size_t>& worker_settled : settled) {
+      heavy.insert(heavy.end(), worker_settled.begin(), worker_settled.end());
+      worker_settled.clear();
+    }
+    relax(heavy, false);
+
+    // Heavy arcs lead to later buckets, but rounding may leave a floating
+    // distance in this one, so the ring is searched from it.
+    std::size_t step = 0;
+    for (; step < slots; step++) {
+      std::size_t const slot = (bucket + step) % slots;
+      bool const found =
+          std::any_of(bins.begin(), bins.end(), [slot](const auto& worker) {
+            return !worker[slot].empty();
+          });
+      if (found) break;
+    }
+    if (step == slots) break;
+    bucket += step;
+    gather();
   }
 
+  std::vector<distance_type> result(vertices,
+                                    static_cast<distance_type>(kUndefined));
+  for (std::size_t v = 0; v < vertices; v++) {
+    distance_type const d =
+        distance[graph.ToStorageId(v)].load(std::memory_order_relaxed);
+    if (d != infinity) result[v] = d;
+  }
   return result;
 }
 
-Matrix GraphAlgoritms::getLeastSpanningTree(Graph& graph) {
-  Matrix adjacency_matrix(graph.AmountOfVertices(), graph.AmountOfVertices());
+template <typename W>
+BasicMatrix<W> GraphAlgoritms::getShortestPathsBetweenAllVertices(
+    const BasicGraph<W>& graph) {
+  W const undefined = static_cast<W>(kUndefined);
+  BasicMatrix<W> result(graph.AmountOfVertices(), graph.AmountOfVertices());
 
-  std::vector<bool> used_vertices(graph.AmountOfVertices(), false);
+  std::size_t const vertices = graph.AmountOfVertices();
+  for (size_t i = 0; i < vertices; i++) {
+    W* row = result.Row(i);
+    std::fill(row, row + vertices, undefined);
+    row[i] = 0;
+  }
+  auto const adjacency = graph.Csr();
+  for (size_t i = 0; i < vertices; i++) {
+    W* row = result.Row(graph.ToOriginalId(i));
+    adjacency->ForEachInRow(i, [&](std::size_t j, W weight) {
+      row[graph.ToOriginalId(j)] = weight;
+    });
+  }
 
-  used_vertices[0] = true;
-  std::pair<std::size_t, std::size_t> coord;
-  for (std::size_t edge = 0; edge < graph.AmountOfVertices() - 1; ++edge) {
-    std::size_t min = std::numeric_limits<std::size_t>::max();
-    coord = {0, 0};
-
-    for (std::size_t i = 0; i < graph.AmountOfVertices(); ++i) {
-      if (used_vertices[i]) {
-        for (std::size_t j = 0; j < graph.AmountOfVertices(); ++j) {
-          std::size_t edge_cost = graph(i, j);
-          if (!used_vertices[j] && edge_cost != 0) {
-            if (min > edge_cost) {
-              min = edge_cost;
-              coord = {i, j};
-            }
+  for (size_t k = 0; k < vertices; k++) {
+    const W* row_k = result.Row(k);
+    for (size_t i = 0; i < vertices; i++) {
+      W* row_i = result.Row(i);
+      W const path_ik = row_i[k];
+      if (path_ik == undefined) continue;
+      for (size_t j = 0; j < vertices; j++) {
+        if (row_k[j] != undefined) {
+          auto const path =
+              static_cast<typename BasicGraph<W>::distance_type>(path_ik) +
+              row_k[j];
+          if (row_i[j] == undefined || path < row_i[j]) {
+            row_i[j] = NarrowDistance<W>(path);
           }
         }
       }
     }
-    adjacency_matrix(coord.first, coord.second) = static_cast<int>(min);
-    adjacency_matrix(coord.second, coord.first) = static_cast<int>(min);
-    used_vertices[coord.second] = true;
+  }
+
+  return result;
+}
+
+template <typename W>
+BasicMatrix<W> GraphAlgoritms::getLeastSpanningTree(
+    const BasicGraph<W>& graph) {
+  if (graph.AmountOfVertices() == 0) return BasicMatrix<W>();
+  BasicMatrix<W> adjacency_matrix(graph.AmountOfVertices(),
+                                  graph.AmountOfVertices());
+
+  std::vector<bool> used_vertices(graph.AmountOfVertices(), false);
+  auto const adjacency = graph.Csr();
+
+  // Candidate edges ordered by (cost, from, to) in original ids: the same
+  // edge the plain "scan every used vertex" Prim would pick, found in
+  // O(E log E).
+  using Edge = std::tuple<W, std::size_t, std::size_t>;
+  std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> edges;
+  auto const add_vertex = [&](std::size_t from) {
+    used_vertices[from] = true;
+    adjacency->ForEachInRow(graph.ToStorageId(from),
+                            [&](std::size_t to, W cost) {
+                              to = graph.ToOriginalId(to);
+                              if (!used_vertices[to]) {
+                                edges.emplace(cost, from, to);
+                              }
+                            });
+  };
+
+  std::size_t spanned = 1;
+  add_vertex(0);
+  while (edges.empty() == false) {
+    auto const [cost, from, to] = edges.top();
+    edges.pop();
+    if (used_vertices[to]) continue;
+
+    adjacency_matrix(from, to) = cost;
+    adjacency_matrix(to, from) = cost;
+    add_vertex(to);
+    spanned++;
+  }
+  if (spanned < graph.AmountOfVertices()) {
+    adjacency_matrix(0, 0) = static_cast<W>(-1);
   }
 
   return adjacency_matrix;
 }
 
+#define S21_INSTANTIATE_GRAPH_ALGORITHMS(W)                                   \
+  template std::vector<int> GraphAlgoritms::depthFirstSearch(                  \
+      const BasicGraph<W>&, int);                                              \
+  template std::vector<int> GraphAlgoritms::breadthFirstSearch(                \
+      const BasicGraph<W>&, int);                                              \
+  template void GraphAlgoritms::depthFirstSearch(                              \
+      const BasicGraph<W>&, int, BasicSearchWorkspace<W>*, std::vector<int>*); \
+  template void GraphAlgoritms::breadthFirstSearch(                            \
+      const BasicGraph<W>&, int, BasicSearchWorkspace<W>*, std::vector<int>*); \
+  template bool GraphAlgoritms::isReachable(const BasicGraph<W>&, int, int);   \
+  template GraphAlgoritms::BfsTree GraphAlgoritms::breadthFirstSearchTree(     \
+      const BasicGraph<W>&, int, BfsMode);                                     \
+  template Matrix GraphAlgoritms::multiSourceBreadthFirstSearch(               \
+      const BasicGraph<W>&, const std::vector<int>&);                          \
+  template GraphAlgoritms::BfsTree GraphAlgoritms::parallelBreadthFirstSearch( \
+      const BasicGraph<W>&, int, unsigned);                                    \
+  template GraphAlgoritms::BfsTree GraphAlgoritms::parallelBreadthFirstSearch( \
+      const BasicGraph<W>&, int, ThreadPool*);                                 \
+  template GraphAlgoritms::HopPath                                             \
+  GraphAlgoritms::bidirectionalBreadthFirstSearch(const BasicGraph<W>&, int,   \
+                                                  int);                        \
+  template GraphAlgoritms::HopPath                                             \
+  GraphAlgoritms::bidirectionalBreadthFirstSearch(                             \
+      const BasicGraph<W>&, int, int, BasicSearchWorkspace<W>*);               \
+  template W GraphAlgoritms::getShortestPathBetweenVertices(                   \
+      const BasicGraph<W>&, int, int);                                         \
+  template W GraphAlgoritms::getShortestPathBetweenVertices(                   \
+      const BasicGraph<W>&, int, int, BasicSearchWorkspace<W>*);               \
+  template W GraphAlgoritms::getShortestPathBetweenVertices(                   \
+      const BasicGraph<W>&, int, int, PriorityQueue,                           \
+      BasicSearchWorkspace<W>*);                                               \
+  template GraphAlgoritms::ShortestPath<W>                                     \
+  GraphAlgoritms::bidirectionalShortestPath(const BasicGraph<W>&, int, int);   \
+  template GraphAlgoritms::ShortestPath<W>                                     \
+  GraphAlgoritms::bidirectionalShortestPath(                                   \
+      const BasicGraph<W>&, int, int, BasicSearchWorkspace<W>*);               \
+  template BasicLandmarks<W> GraphAlgoritms::selectLandmarks(                  \
+      const BasicGraph<W>&, std::size_t);                                      \
+  template GraphAlgoritms::ShortestPath<W> GraphAlgoritms::altShortestPath(    \
+      const BasicGraph<W>&, const BasicLandmarks<W>&, int, int);               \
+  template GraphAlgoritms::ShortestPath<W> GraphAlgoritms::altShortestPath(    \
+      const BasicGraph<W>&, const BasicLandmarks<W>&, int, int,                \
+      BasicSearchWorkspace<W>*);                                               \
+  template std::vector<BasicGraph<W>::distance_type>                           \
+  GraphAlgoritms::getShortestPathsFromVertex(const BasicGraph<W>&, int);       \
+  template std::vector<BasicGraph<W>::distance_type>                           \
+  GraphAlgoritms::deltaSteppingShortestPaths(const BasicGraph<W>&, int,        \
+                                             unsigned, W);                     \
+  template std::vector<BasicGraph<W>::distance_type>                           \
+  GraphAlgoritms::deltaSteppingShortestPaths(const BasicGraph<W>&, int,        \
+                                             ThreadPool*, W);                  \
+  template GraphAlgoritms::ShortestPath<W> GraphAlgoritms::getShortestPath(    \
+      const BasicGraph<W>&, int, int);                                         \
+  template GraphAlgoritms::ShortestPath<W> GraphAlgoritms::getShortestPath(    \
+      const BasicGraph<W>&, int, int, BasicSearchWorkspace<W>*);               \
+  template BasicMatrix<W>                                                      \
+  GraphAlgoritms::getShortestPathsBetweenAllVertices(const BasicGraph<W>&);    \
+  template BasicMatrix<W> GraphAlgoritms::getLeastSpanningTree(                \
+      const BasicGraph<W>&);                                                   \
+  template GraphAlgoritms::Components                                          \
+  GraphAlgoritms::weaklyConnectedComponents(const BasicGraph<W>&);             \
+  template GraphAlgoritms::Components                                          \
+  GraphAlgoritms::parallelWeaklyConnectedComponents(const BasicGraph<W>&,      \
+                                                    unsigned);                 \
+  template GraphAlgoritms::Components                                          \
+  GraphAlgoritms::parallelWeaklyConnectedComponents(const BasicGraph<W>&,      \
+                                                    ThreadPool*);              \
+  template GraphAlgoritms::Components                                          \
+  GraphAlgoritms::stronglyConnectedComponents(const BasicGraph<W>&);
+
+S21_FOR_EACH_CELL_TYPE(S21_INSTANTIATE_GRAPH_ALGORITHMS)
+
+#undef S21_INSTANTIATE_GRAPH_ALGORITHMS
+
 }  // namespace s21
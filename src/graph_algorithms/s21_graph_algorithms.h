@@ -2,34 +2,412 @@
 #define SRC_GRAPH_ALGORITHMS_S21_GRAPH_ALGORITHMS_H_
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <queue>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "../containers/s21_containers.h"
 #include "../graph/s21_graph.h"
+#include "../graph/s21_parallel.h"
 #include "ant_colony/ant_colony.h"
+#include "s21_landmarks.h"
+#include "s21_search_workspace.h"
 
 namespace s21 {
 
+// Hooks of GraphAlgoritms::depthFirstVisit and breadthFirstVisit, all of
+// them doing nothing. A visitor derives from it and hides the hooks it
+// needs; the calls are resolved at compile time, so they inline into the
+// search loop. Every hook returns false to stop the search. Vertices are
+// numbered from 1.
+template <typename W>
+struct BasicSearchVisitor {
+  // The vertex is reached for the first time and put on the stack or queue.
+  bool DiscoverVertex(int) { return true; }
+  // The vertex is taken off the stack or queue, in the order
+  // depthFirstSearch and breadthFirstSearch return the vertices.
+  bool ExamineVertex(int) { return true; }
+  // Called for every arc leaving an examined vertex, before its target is
+  // discovered.
+  bool ExamineEdge(int, int, W) { return true; }
+  // All arcs leaving the vertex have been examined.
+  bool FinishVertex(int) { return true; }
+};
+
+using SearchVisitor = BasicSearchVisitor<int>;
+
 class GraphAlgoritms {
  public:
-  tsm::TsmResult SolveTravelingSalesmanProblem(Graph& graph);
-  tsm::TsmResult NaiveSolveTravelingSalesmanProblem(Graph& graph);
-  tsm::TsmResult NearestNeighborSolveTravelingSalesmanProblem(Graph& graph);
+  enum class BfsMode {
+    kTopDown,              // expand the frontier through its out-arcs
+    kBottomUp,             // unvisited vertices look for a frontier parent
+    kDirectionOptimizing   // switch between the two level by level
+  };
+
+  // Breadth-first search tree, vertices numbered from 1. visited holds the
+  // reached vertices level by level (the set breadthFirstSearch visits);
+  // parent and level are indexed by vertex - 1 and are -1 for unreached
+  // vertices; the start vertex is its own parent.
+  struct BfsTree {
+    std::vector<int> visited;
+    std::vector<int> parent;
+    std::vector<int> level;
+  };
+
+  // A path as vertices numbered from 1 and its number of arcs; hops is -1
+  // and vertices is empty when there is no path.
+  struct HopPath {
+    int hops = -1;
+    std::vector<int> vertices;
+  };
+
+  // Priority queue of the single-pair shortest path search. Dijkstra pops
+  // distances in non-decreasing order, which for non-negative integer
+  // weights the monotone queues exploit without comparing keys: Dial's
+  // keeps a ring of MaxWeight() + 1 buckets, one per distance, suiting
+  // small bounded weights, and falls back to the radix heap above
+  // BucketQueue::kMaxStep; the radix heap files a key by the highest bit
+  // it differs in from the last popped one, for any weights.
+  enum class PriorityQueue { kHeap, kDial, kRadixHeap };
+
+  // A shortest path as vertices numbered from 1 and its length; distance
+  // is -1 and vertices is empty when there is no path.
+  template <typename W>
+  struct ShortestPath {
+    typename BasicGraph<W>::distance_type distance = -1;
+    std::vector<int> vertices;
+  };
+
+  // The component of every vertex, indexed by vertex - 1. Components are
+  // numbered from 0 in the order of their smallest vertex, so equal
+  // partitions get equal numbers whatever algorithm found them.
+  struct Components {
+    int count = 0;
+    std::vector<int> component;
+  };
+
+  tsm::TsmResult SolveTravelingSalesmanProblem(const Graph& graph);
+  tsm::TsmResult NaiveSolveTravelingSalesmanProblem(const Graph& graph);
+  tsm::TsmResult NearestNeighborSolveTravelingSalesmanProblem(
+      const Graph& graph);
+
+  // The searches and path algorithms work on every weight type BasicGraph is
+  // instantiated for. Path lengths are summed in BasicGraph::distance_type,
+  // which is std::int64_t for the integer weights.
+  //
+  // Searches given a workspace allocate nothing once the workspace and the
+  // result have grown to the size of the graph; the forms without one use
+  // a workspace kept per thread.
+  // Searches from startVertex calling the hooks of the visitor (see
+  // BasicSearchVisitor); return false if a hook stopped them. The depth-first
+  // one is the stack-based search of depthFirstSearch: a vertex is
+  // discovered when pushed and finished once its arcs are pushed, not after
+  // its descendants. The hooks must not run another search on the same
+  // workspace; without one the workspace of the thread is used.
+  template <typename W, typename Visitor>
+  bool depthFirstVisit(const BasicGraph<W>& graph, int startVertex,
+                       Visitor&& visitor,
+                       BasicSearchWorkspace<W>* workspace = nullptr);
+  template <typename W, typename Visitor>
+  bool breadthFirstVisit(const BasicGraph<W>& graph, int startVertex,
+                         Visitor&& visitor,
+                         BasicSearchWorkspace<W>* workspace = nullptr);
+  // Whether a path leads from vertex1 to vertex2; the breadth-first search
+  // stops as soon as it discovers vertex2.
+  template <typename W>
+  bool isReachable(const BasicGraph<W>& graph, int vertex1, int vertex2);
+
+  template <typename W>
+  std::vector<int> depthFirstSearch(const BasicGraph<W>& graph,
+                                    int startVertex);
+  template <typename W>
+  void depthFirstSearch(const BasicGraph<W>& graph, int startVertex,
+                        BasicSearchWorkspace<W>* workspace,
+                        std::vector<int>* result);
+  template <typename W>
+  std::vector<int> breadthFirstSearch(const BasicGraph<W>& graph,
+                                      int startVertex);
+  template <typename W>
+  void breadthFirstSearch(const BasicGraph<W>& graph, int startVertex,
+                          BasicSearchWorkspace<W>* workspace,
+                          std::vector<int>* result);
+  // Level-synchronous BFS that also records the tree. In the
+  // direction-optimizing mode (Beamer et al.) a level is expanded bottom-up
+  // once the arcs leaving the frontier outnumber 1/14 of the arcs still
+  // to be checked, which skips most arcs of low-diameter graphs, and
+  // top-down again once the frontier holds less than 1/24 of the vertices.
+  template <typename W>
+  BfsTree breadthFirstSearchTree(
+      const BasicGraph<W>& graph, int startVertex,
+      BfsMode mode = BfsMode::kDirectionOptimizing);
+  // Level-synchronous BFS with every level expanded by the workers of the
+  // pool: they take frontier chunks from a shared counter, claim vertices
+  // with a compare-and-swap on their parent and collect them in buffers
+  // of their own, which are then copied side by side into the next
+  // frontier. The order inside a level depends on the scheduling. The
+  // second form runs on a pool of threads workers made for the call.
+  template <typename W>
+  BfsTree parallelBreadthFirstSearch(const BasicGraph<W>& graph,
+                                     int startVertex, ThreadPool* pool);
+  template <typename W>
+  BfsTree parallelBreadthFirstSearch(const BasicGraph<W>& graph,
+                                     int startVertex, unsigned threads = 0);
+  // A path with the fewest arcs from vertex1 to vertex2, found by
+  // bidirectional BFS: one search runs forward from vertex1, another one
+  // backwards from vertex2 over the reverse arcs, and the side with the
+  // smaller frontier expands a level until they meet. On graphs of low
+  // diameter this visits about the square root of the vertices a search
+  // from one end does.
+  template <typename W>
+  HopPath bidirectionalBreadthFirstSearch(const BasicGraph<W>& graph,
+                                          int vertex1, int vertex2);
+  template <typename W>
+  HopPath bidirectionalBreadthFirstSearch(const BasicGraph<W>& graph,
+                                          int vertex1, int vertex2,
+                                          BasicSearchWorkspace<W>* workspace);
+  // Hop distances from many sources at once (multi-source BFS): row s of
+  // the result holds the number of arcs on a shortest path from
+  // sources[s] to every vertex, -1 for unreachable ones, which is what
+  // closeness and eccentricity are computed from. The sources are run 64
+  // at a time, every vertex keeping a bit mask of the sources that have
+  // reached it, so an arc is scanned once per level of a batch instead of
+  // once per source.
+  template <typename W>
+  Matrix multiSourceBreadthFirstSearch(const BasicGraph<W>& graph,
+                                       const std::vector<int>& sources);
+  // The same searches on the bit-packed adjacency (see
+  // BasicGraph::ToBitMatrix), visiting vertices in the same order: the
+  // unvisited neighbours of a vertex are taken 64 at a time as
+  // row & ~visited. A non-square adjacency throws std::invalid_argument.
+  std::vector<int> depthFirstSearch(const BitMatrix& adjacency,
+                                    int startVertex);
+  std::vector<int> breadthFirstSearch(const BitMatrix& adjacency,
+                                      int startVertex);
 
-  std::vector<int> depthFirstSearch(Graph& graph, int startVertex);
-  std::vector<int> breadthFirstSearch(Graph& graph, int startVertex);
-  int getShortestPathBetweenVertices(Graph& graph, int vertex1, int vertex2);
-  Matrix getShortestPathsBetweenAllVertices(Graph& graph);
+  // Dijkstra on the adjacency lists with an indexed 4-ary heap
+  // (decrease-key, no stale entries), stopping once vertex2 is settled:
+  // O((V + E) log V) and usually far less. Uniform weights take the
+  // bidirectional BFS instead. getShortestPath also returns the path. The
+  // searches sum BasicGraph::distance_type lengths; the functions returning
+  // W throw std::overflow_error if the length does not fit it.
+  template <typename W>
+  W getShortestPathBetweenVertices(const BasicGraph<W>& graph, int vertex1,
+                                   int vertex2);
+  template <typename W>
+  W getShortestPathBetweenVertices(const BasicGraph<W>& graph, int vertex1,
+                                   int vertex2,
+                                   BasicSearchWorkspace<W>* workspace);
+  // Dijkstra on the given queue; kDial and kRadixHeap throw
+  // std::invalid_argument on floating-point or negative weights.
+  template <typename W>
+  W getShortestPathBetweenVertices(
+      const BasicGraph<W>& graph, int vertex1, int vertex2,
+      PriorityQueue queue, BasicSearchWorkspace<W>* workspace = nullptr);
+  template <typename W>
+  ShortestPath<W> getShortestPath(const BasicGraph<W>& graph, int vertex1,
+                                  int vertex2);
+  template <typename W>
+  ShortestPath<W> getShortestPath(const BasicGraph<W>& graph, int vertex1,
+                                  int vertex2,
+                                  BasicSearchWorkspace<W>* workspace);
+  // getShortestPath by bidirectional Dijkstra: a forward search from
+  // vertex1 and a backward one from vertex2 over the reverse arcs, growing
+  // whichever settled ball has the smaller radius, and stopping once the
+  // two radii add up to the shortest path joining the balls found so far.
+  // Settles about half the vertices of the one-sided search when the
+  // balls stay apart, which is typical of road networks.
+  template <typename W>
+  ShortestPath<W> bidirectionalShortestPath(const BasicGraph<W>& graph,
+                                            int vertex1, int vertex2);
+  template <typename W>
+  ShortestPath<W> bidirectionalShortestPath(
+      const BasicGraph<W>& graph, int vertex1, int vertex2,
+      BasicSearchWorkspace<W>* workspace);
+  // ALT preprocessing: picks count landmarks by farthest selection (each
+  // the vertex farthest from those before) and records the distances
+  // from and to each of them, 2 * count Dijkstra runs in all. The tables
+  // can be saved, so this is paid once per graph content.
+  template <typename W>
+  BasicLandmarks<W> selectLandmarks(const BasicGraph<W>& graph,
+                                    std::size_t count);
+  // getShortestPath by A* with the landmark lower bounds, which settles a
+  // narrow band around the shortest path instead of a ball; throws
+  // std::invalid_argument if the landmarks do not fit the graph.
+  template <typename W>
+  ShortestPath<W> altShortestPath(const BasicGraph<W>& graph,
+                                  const BasicLandmarks<W>& landmarks,
+                                  int vertex1, int vertex2);
+  template <typename W>
+  ShortestPath<W> altShortestPath(const BasicGraph<W>& graph,
+                                  const BasicLandmarks<W>& landmarks,
+                                  int vertex1, int vertex2,
+                                  BasicSearchWorkspace<W>* workspace);
+  // Distances from startVertex to every vertex, indexed by vertex - 1 and
+  // -1 for unreachable ones, by Dijkstra on the indexed heap.
+  template <typename W>
+  std::vector<typename BasicGraph<W>::distance_type> getShortestPathsFromVertex(
+      const BasicGraph<W>& graph, int startVertex);
+  // The same distances by delta-stepping (Meyer and Sanders) on the
+  // workers of the pool. Vertices sit in buckets of distances
+  // [i * delta, (i + 1) * delta); the lowest non-empty bucket is emptied
+  // by relaxing the light arcs (weight <= delta) of its vertices in
+  // parallel, rounds repeating while they put vertices back into it, and
+  // then their heavy arcs once; the live buckets are kept in a ring of
+  // ceil(MaxWeight() / delta) + 1 slots. Distances are lowered with an atomic
+  // compare-and-swap minimum, so the result equals the sequential one. A
+  // delta of 0 is taken as MaxWeight() * V / E, the largest weight over the
+  // average out-degree (Meyer and Sanders' choice for random weights), and
+  // a delta below MaxWeight() / 2^16 is raised to it to bound the ring;
+  // throws std::invalid_argument on negative weights or delta.
+  template <typename W>
+  std::vector<typename BasicGraph<W>::distance_type> deltaSteppingShortestPaths(
+      const BasicGraph<W>& graph, int startVertex, ThreadPool* pool,
+      W delta = 0);
+  template <typename W>
+  std::vector<typename BasicGraph<W>::distance_type> deltaSteppingShortestPaths(
+      const BasicGraph<W>& graph, int startVertex, unsigned threads = 0,
+      W delta = 0);
+  // Floyd-Warshall in O(V^3); throws std::overflow_error if a distance
+  // does not fit W.
+  template <typename W>
+  BasicMatrix<W> getShortestPathsBetweenAllVertices(
+      const BasicGraph<W>& graph);
 
-  Matrix getLeastSpanningTree(Graph& graph);
+  // Prim's tree from vertex 1, ties broken by the smaller original ids. If
+  // some vertex is not reachable from vertex 1 there is no spanning tree:
+  // the tree of the reachable ones is returned with -1 at (1, 1).
+  template <typename W>
+  BasicMatrix<W> getLeastSpanningTree(const BasicGraph<W>& graph);
+
+  // Weakly connected components (arc directions ignored) by union-find
+  // with union by size and path halving, in O(E α(V)). The parallel form
+  // links the arcs of chunks of vertices on every worker of the pool with
+  // a lock-free union-find, roots being hooked to smaller roots by
+  // compare-and-swap, in O(E log V). Two vertices with different
+  // components have no path between them in either direction.
+  template <typename W>
+  Components weaklyConnectedComponents(const BasicGraph<W>& graph);
+  template <typename W>
+  Components parallelWeaklyConnectedComponents(const BasicGraph<W>& graph,
+                                               ThreadPool* pool);
+  template <typename W>
+  Components parallelWeaklyConnectedComponents(const BasicGraph<W>& graph,
+                                               unsigned threads = 0);
+  // Strongly connected components by Tarjan's algorithm with an explicit
+  // stack, in O(V + E): vertex2 is reachable from vertex1 and back exactly
+  // when both are in the same component. On undirected graphs they are the
+  // weakly connected components.
+  template <typename W>
+  Components stronglyConnectedComponents(const BasicGraph<W>& graph);
 
  private:
   const int kUndefined = -1;
+
+  // Checks startVertex and prepares the workspace of a visitor search.
+  template <typename W>
+  static BasicSearchWorkspace<W>* StartVisit(
+      const BasicGraph<W>& graph, int startVertex,
+      BasicSearchWorkspace<W>* workspace);
 };
 
+template <typename W>
+BasicSearchWorkspace<W>* GraphAlgoritms::StartVisit(
+    const BasicGraph<W>& graph, int startVertex,
+    BasicSearchWorkspace<W>* workspace) {
+  if (startVertex < 1 || (std::size_t)startVertex > graph.AmountOfVertices()) {
+    throw std::out_of_range("startVertex is out of range");
+  }
+  if (workspace == nullptr) {
+    workspace = &BasicSearchWorkspace<W>::ForThisThread();
+  }
+  workspace->Reset(graph.AmountOfVertices());
+  return workspace;
+}
+
+template <typename W, typename Visitor>
+bool GraphAlgoritms::depthFirstVisit(const BasicGraph<W>& graph,
+                                     int startVertex, Visitor&& visitor,
+                                     BasicSearchWorkspace<W>* workspace) {
+  workspace = StartVisit(graph, startVertex, workspace);
+  auto const adjacency = graph.Csr();
+  const auto* columns = adjacency->Columns();
+  const W* values = adjacency->Values();
+  // Only a reordered graph needs its rows permuted to original order.
+  auto const by_id = graph.IsReordered() ? graph.ArcsByOriginalId() : nullptr;
+  std::vector<std::size_t>& vertices = workspace->Frontier();
+
+  // The search runs on storage ids, see BasicGraph::Reorder, but walks the
+  // arcs in original order, so it visits the vertices in the same order.
+  std::size_t const start = graph.ToStorageId((std::size_t)startVertex - 1);
+  workspace->Visit(start);
+  if (!visitor.DiscoverVertex(startVertex)) return false;
+  vertices.push_back(start);
+
+  while (!vertices.empty()) {
+    std::size_t const from = vertices.back();
+    vertices.pop_back();
+    int const from_id = (int)graph.ToOriginalId(from) + 1;
+    if (!visitor.ExamineVertex(from_id)) return false;
+
+    std::size_t const end = adjacency->RowEnd(from);
+    for (std::size_t k = adjacency->RowBegin(from); k < end; k++) {
+      std::size_t const arc = by_id != nullptr ? (*by_id)[k] : k;
+      std::size_t const to = columns[arc];
+      int const to_id = (int)graph.ToOriginalId(to) + 1;
+      if (!visitor.ExamineEdge(from_id, to_id, values[arc])) return false;
+      if (workspace->IsVisited(to)) continue;
+      workspace->Visit(to);
+      if (!visitor.DiscoverVertex(to_id)) return false;
+      vertices.push_back(to);
+    }
+    if (!visitor.FinishVertex(from_id)) return false;
+  }
+  return true;
+}
+
+template <typename W, typename Visitor>
+bool GraphAlgoritms::breadthFirstVisit(const BasicGraph<W>& graph,
+                                       int startVertex, Visitor&& visitor,
+                                       BasicSearchWorkspace<W>* workspace) {
+  workspace = StartVisit(graph, startVertex, workspace);
+  auto const adjacency = graph.Csr();
+  const auto* columns = adjacency->Columns();
+  const W* values = adjacency->Values();
+  auto const by_id = graph.IsReordered() ? graph.ArcsByOriginalId() : nullptr;
+  // Every vertex is queued once, so the queue is a plain array.
+  std::vector<std::size_t>& vertices = workspace->Frontier();
+
+  std::size_t const start = graph.ToStorageId((std::size_t)startVertex - 1);
+  workspace->Visit(start);
+  if (!visitor.DiscoverVertex(startVertex)) return false;
+  vertices.push_back(start);
+
+  for (std::size_t head = 0; head < vertices.size(); head++) {
+    std::size_t const from = vertices[head];
+    int const from_id = (int)graph.ToOriginalId(from) + 1;
+    if (!visitor.ExamineVertex(from_id)) return false;
+
+    std::size_t const end = adjacency->RowEnd(from);
+    for (std::size_t k = adjacency->RowBegin(from); k < end; k++) {
+      std::size_t const arc = by_id != nullptr ? (*by_id)[k] : k;
+      std::size_t const to = columns[arc];
+      int const to_id = (int)graph.ToOriginalId(to) + 1;
+      if (!visitor.ExamineEdge(from_id, to_id, values[arc])) return false;
+      if (workspace->IsVisited(to)) continue;
+      workspace->Visit(to);
+      if (!visitor.DiscoverVertex(to_id)) return false;
+      vertices.push_back(to);
+    }
+    if (!visitor.FinishVertex(from_id)) return false;
+  }
+  return true;
+}
+
 }  // namespace s21
 
 #endif  // SRC_GRAPH_ALGORITHMS_S21_GRAPH_ALGORITHMS_H_
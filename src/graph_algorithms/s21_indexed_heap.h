@@ -0,0 +1,108 @@
+#ifndef SRC_GRAPH_ALGORITHMS_S21_INDEXED_HEAP_H_
+#define SRC_GRAPH_ALGORITHMS_S21_INDEXED_HEAP_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Min-heap of vertices 0 .. vertices - 1 keyed by distance, D children per
+// node, that knows where every vertex sits so a key can be lowered in
+// place (decrease-key) instead of pushing a second entry. A wider node
+// halves the depth of a binary heap, which shortens the sift-up of a
+// decrease-key, and keeps the children of a node in one or two cache
+// lines, so the extra comparisons of a pop's sift-down stay cheap. Ties go
+// to the smaller vertex.
+// The caller tracks which vertices are in the heap: the positions of the
+// others are stale. Defined here so the sifts inline into the searches.
+template <typename W, std::size_t D = 4>
+class IndexedHeap {
+ public:
+  using entry = std::pair<W, std::size_t>;
+
+  // Empties the heap for vertices vertices.
+  void Reset(std::size_t vertices);
+
+  bool Empty() const { return entries_.empty(); }
+  std::size_t Size() const { return entries_.size(); }
+  // The vertex with the smallest key and its key.
+  const entry& Top() const { return entries_.front(); }
+
+  void Pop();
+  // vertex must not be in the heap.
+  void Push(std::size_t vertex, W key);
+  // vertex must be in the heap with a key of at least key.
+  void DecreaseKey(std::size_t vertex, W key);
+
+ private:
+  std::vector<entry> entries_;
+  std::vector<std::size_t> positions_;
+
+  void Place(std::size_t position, const entry& e) {
+    entries_[position] = e;
+    positions_[e.second] = position;
+  }
+  void SiftUp(std::size_t position, entry e);
+  void SiftDown(std::size_t position, entry e);
+};
+
+template <typename W, std::size_t D>
+void IndexedHeap<W, D>::Reset(std::size_t vertices) {
+  if (positions_.size() < vertices) positions_.resize(vertices);
+  // Every vertex is in the heap at most once.
+  entries_.reserve(vertices);
+  entries_.clear();
+}
+
+template <typename W, std::size_t D>
+void IndexedHeap<W, D>::Pop() {
+  entry const last = entries_.back();
+  entries_.pop_back();
+  if (!entries_.empty()) SiftDown(0, last);
+}
+
+template <typename W, std::size_t D>
+void IndexedHeap<W, D>::Push(std::size_t vertex, W key) {
+  entries_.emplace_back();
+  SiftUp(entries_.size() - 1, entry(key, vertex));
+}
+
+template <typename W, std::size_t D>
+void IndexedHeap<W, D>::DecreaseKey(std::size_t vertex, W key) {
+  SiftUp(positions_[vertex], entry(key, vertex));
+}
+
+// Both sifts move the hole instead of swapping and place e once at the end.
+template <typename W, std::size_t D>
+void IndexedHeap<W, D>::SiftUp(std::size_t position, entry e) {
+  while (position > 0) {
+    std::size_t const parent = (position - 1) / D;
+    if (!(e < entries_[parent])) break;
+    Place(position, entries_[parent]);
+    position = parent;
+  }
+  Place(position, e);
+}
+
+template <typename W, std::size_t D>
+void IndexedHeap<W, D>::SiftDown(std::size_t position, entry e) {
+  std::size_t const size = entries_.size();
+  for (;;) {
+    std::size_t const first = position * D + 1;
+    if (first >= size) break;
+    std::size_t const last = first + D < size ? first + D : size;
+    std::size_t best = first;
+    for (std::size_t child = first + 1; child < last; child++) {
+      if (entries_[child] < entries_[best]) best = child;
+    }
+    if (!(entries_[best] < e)) break;
+    Place(position, entries_[best]);
+    position = best;
+  }
+  Place(position, e);
+}
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_ALGORITHMS_S21_INDEXED_HEAP_H_
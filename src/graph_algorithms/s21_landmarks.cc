@@ -0,0 +1,161 @@
+#include "s21_landmarks.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "../graph/s21_graph_binary.h"
+
+namespace s21 {
+
+namespace {
+
+// On-disk layout of BasicLandmarks::Save files (native byte order): the
+// header, then count uint64 landmarks (original vertices from 0), then
+// vertices * count * directions distances, vertex-major as in memory and
+// of BasicGraph::distance_type (int64 for the integer weight types); each
+// section starts at a multiple of binary::kSectionAlignment bytes.
+constexpr char kMagic[4] = {'S', '2', '1', 'L'};
+constexpr std::uint32_t kVersion = 1;
+
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint64_t vertices;
+  std::uint64_t arcs;
+  std::uint64_t graph_version;
+  std::uint64_t graph_fingerprint;
+  std::uint64_t count;
+  binary::WeightType weight_type;
+  std::uint8_t directions;
+  std::uint8_t reserved[6];
+};
+
+}  // namespace
+
+template <typename W>
+std::vector<int> BasicLandmarks<W>::GetLandmarks() const {
+  std::vector<int> landmarks;
+  landmarks.reserve(landmarks_.size());
+  for (std::size_t l : landmarks_) landmarks.push_back((int)l + 1);
+  return landmarks;
+}
+
+template <typename W>
+bool BasicLandmarks<W>::Fits(const BasicGraph<W>& graph) const {
+  return vertices_ == graph.AmountOfVertices() &&
+         arcs_ == graph.Csr()->GetNonZeros() &&
+         graph_fingerprint_ == graph.Fingerprint();
+}
+
+template <typename W>
+void BasicLandmarks<W>::Save(const std::string& filename) const {
+  std::ofstream outfile(filename, std::ios::binary);
+  if (outfile.is_open() == false) {
+    throw std::runtime_error("Could not open file");
+  }
+
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.vertices = vertices_;
+  header.arcs = arcs_;
+  header.graph_version = graph_version_;
+  header.graph_fingerprint = graph_fingerprint_;
+  header.count = landmarks_.size();
+  header.weight_type = binary::WeightTypeOf<W>();
+  header.directions = (std::uint8_t)directions_;
+
+  std::uint64_t position = 0;
+  auto const write_section = [&outfile, &position](const void* section,
+                                                   std::uint64_t bytes) {
+    std::vector<char> const padding(binary::AlignSection(position) - position,
+                                    0);
+    outfile.write(padding.data(), (std::streamsize)padding.size());
+    outfile.write(static_cast<const char*>(section), (std::streamsize)bytes);
+    position = binary::AlignSection(position) + bytes;
+  };
+  std::vector<std::uint64_t> const landmarks(landmarks_.begin(),
+                                             landmarks_.end());
+  write_section(&header, sizeof(header));
+  write_section(landmarks.data(), landmarks.size() * sizeof(std::uint64_t));
+  write_section(table_.data(), table_.size() * sizeof(distance_type));
+  if (!outfile) {
+    throw std::runtime_error("Could not write file");
+  }
+}
+
+template <typename W>
+void BasicLandmarks<W>::Load(const std::string& filename) {
+  std::ifstream infile(filename, std::ios::binary | std::ios::ate);
+  if (infile.is_open() == false) {
+    throw std::runtime_error("Could not open file");
+  }
+  std::uint64_t const size = (std::uint64_t)infile.tellg();
+  infile.seekg(0);
+
+  Header header;
+  if (size < sizeof(header) ||
+      !infile.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    throw std::runtime_error("Invalid landmark file");
+  }
+  if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0 ||
+      header.version != kVersion ||
+      header.weight_type != binary::WeightTypeOf<W>() ||
+      (header.directions != 1 && header.directions != 2)) {
+    throw std::runtime_error("Unsupported landmark file");
+  }
+  std::uint64_t const landmarks_offset = binary::AlignSection(sizeof(header));
+  if (header.count > size ||
+      (header.count > 0 && header.vertices > size / header.count)) {
+    throw std::runtime_error("Invalid landmark file");
+  }
+  std::uint64_t const table_offset = binary::AlignSection(
+      landmarks_offset + header.count * sizeof(std::uint64_t));
+  std::uint64_t const cells =
+      header.vertices * header.count * header.directions;
+  if (table_offset > size ||
+      cells > (size - table_offset) / sizeof(distance_type)) {
+    throw std::runtime_error("Invalid landmark file");
+  }
+
+  BasicLandmarks loaded;
+  loaded.vertices_ = header.vertices;
+  loaded.arcs_ = header.arcs;
+  loaded.graph_version_ = header.graph_version;
+  loaded.graph_fingerprint_ = header.graph_fingerprint;
+  loaded.directions_ = header.directions;
+  std::vector<std::uint64_t> landmarks(header.count);
+  loaded.table_.resize(cells);
+  infile.seekg((std::streamoff)landmarks_offset);
+  infile.read(reinterpret_cast<char*>(landmarks.data()),
+              (std::streamsize)(landmarks.size() * sizeof(std::uint64_t)));
+  infile.seekg((std::streamoff)table_offset);
+  infile.read(reinterpret_cast<char*>(loaded.table_.data()),
+              (std::streamsize)(cells * sizeof(distance_type)));
+  if (!infile) {
+    throw std::runtime_error("Invalid landmark file");
+  }
+  for (std::uint64_t l : landmarks) {
+    if (l >= header.vertices) {
+      throw std::runtime_error("Invalid landmark file");
+    }
+    loaded.landmarks_.push_back(l);
+  }
+  *this = std::move(loaded);
+}
+
+template <typename W>
+void BasicLandmarks<W>::Load(const std::string& filename,
+                             const BasicGraph<W>& graph) {
+  BasicLandmarks loaded;
+  loaded.Load(filename);
+  if (!loaded.Fits(graph)) {
+    throw std::runtime_error("Landmark file was made for another graph");
+  }
+  *this = std::move(loaded);
+}
+
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicLandmarks)
+
+}  // namespace s21
@@ -0,0 +1,106 @@
+#ifndef SRC_GRAPH_ALGORITHMS_S21_LANDMARKS_H_
+#define SRC_GRAPH_ALGORITHMS_S21_LANDMARKS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../graph/s21_graph.h"
+
+namespace s21 {
+
+class GraphAlgoritms;
+
+// Distance tables of the ALT point-to-point search (A*, landmarks and
+// the triangle inequality), made by GraphAlgoritms::selectLandmarks and
+// used by GraphAlgoritms::altShortestPath. For every landmark L they hold
+// d(L, v) and d(v, L) of every vertex v; since
+//   d(v, t) >= d(L, t) - d(L, v)  and  d(v, t) >= d(v, L) - d(t, L),
+// the largest of these over the landmarks is a lower bound on the
+// distance left to the target, which steers A* towards it. The distances
+// of a vertex to all landmarks are adjacent, so a bound reads two short
+// runs; undirected graphs store one direction. Unreachable is kInfinity.
+//
+// Tables are indexed by original vertex, survive reordering and can be
+// saved next to the graph. Fits compares BasicGraph::Fingerprint, so the
+// tables serve any graph of the same content (a copy, a reordering, the
+// file loaded again) and altShortestPath rejects them after any change to
+// the arcs or weights.
+template <typename W>
+class BasicLandmarks {
+ public:
+  using distance_type = typename BasicGraph<W>::distance_type;
+
+  static constexpr distance_type kInfinity =
+      std::numeric_limits<distance_type>::max();
+
+  BasicLandmarks() = default;
+
+  std::size_t GetCount() const { return landmarks_.size(); }
+  std::size_t GetVertices() const { return vertices_; }
+  std::uint64_t GetGraphVersion() const { return graph_version_; }
+  std::uint64_t GetGraphFingerprint() const { return graph_fingerprint_; }
+  // The landmarks, numbered from 1.
+  std::vector<int> GetLandmarks() const;
+  // Whether the tables were made for a graph of the same content.
+  bool Fits(const BasicGraph<W>& graph) const;
+
+  // d(L, v) and d(v, L) of landmark l, vertices numbered from 0.
+  distance_type FromLandmark(std::size_t l, std::size_t v) const {
+    return table_[(v * GetCount() + l) * directions_];
+  }
+  distance_type ToLandmark(std::size_t l, std::size_t v) const {
+    return table_[(v * GetCount() + l) * directions_ + directions_ - 1];
+  }
+  // A lower bound on d(v, t), vertices numbered from 0.
+  distance_type LowerBound(std::size_t v, std::size_t t) const;
+
+  // Versioned binary format of native byte order, see s21_landmarks.cc.
+  // All throw std::runtime_error, the second Load also if the tables do
+  // not fit the graph.
+  void Save(const std::string& filename) const;
+  void Load(const std::string& filename);
+  void Load(const std::string& filename, const BasicGraph<W>& graph);
+
+ private:
+  friend class GraphAlgoritms;
+
+  std::size_t vertices_ = 0;
+  std::size_t arcs_ = 0;
+  std::uint64_t graph_version_ = 0;
+  std::uint64_t graph_fingerprint_ = 0;
+  std::size_t directions_ = 1;
+  std::vector<std::size_t> landmarks_;
+  std::vector<distance_type> table_;
+};
+
+template <typename W>
+typename BasicLandmarks<W>::distance_type BasicLandmarks<W>::LowerBound(
+    std::size_t v, std::size_t t) const {
+  std::size_t const stride = GetCount() * directions_;
+  const distance_type* at_v = table_.data() + v * stride;
+  const distance_type* at_t = table_.data() + t * stride;
+  distance_type bound = 0;
+  for (std::size_t k = 0; k < stride; k += directions_) {
+    distance_type const from_v = at_v[k], from_t = at_t[k];
+    if (from_v != kInfinity && from_t != kInfinity && from_t - from_v > bound) {
+      bound = from_t - from_v;
+    }
+    distance_type const to_v = at_v[k + directions_ - 1];
+    distance_type const to_t = at_t[k + directions_ - 1];
+    if (to_v != kInfinity && to_t != kInfinity && to_v - to_t > bound) {
+      bound = to_v - to_t;
+    }
+  }
+  return bound;
+}
+
+using Landmarks = BasicLandmarks<int>;
+
+S21_DECLARE_FOR_CELL_TYPES(BasicLandmarks)
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_ALGORITHMS_S21_LANDMARKS_H_
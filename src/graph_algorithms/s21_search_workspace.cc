@@ -0,0 +1,43 @@
+#include "s21_search_workspace.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+template <typename W>
+BasicSearchWorkspace<W>& BasicSearchWorkspace<W>::ForThisThread() {
+  static thread_local BasicSearchWorkspace workspace;
+  return workspace;
+}
+
+template <typename W>
+void BasicSearchWorkspace<W>::Reset(std::size_t vertices) {
+  if (visited_.size() < vertices) {
+    visited_.resize(vertices, 0);
+    reached_.resize(vertices, 0);
+    distances_.resize(vertices);
+    parents_.resize(vertices);
+  }
+  if (++epoch_ == 0) {
+    // The stamps wrapped around: old ones could look current.
+    std::fill(visited_.begin(), visited_.end(), 0);
+    std::fill(reached_.begin(), reached_.end(), 0);
+    epoch_ = 1;
+  }
+  // Every vertex enters the frontier at most once per search.
+  frontier_.reserve(vertices);
+  frontier_.clear();
+  reverse_frontier_.reserve(vertices);
+  reverse_frontier_.clear();
+  heap_.Reset(vertices);
+}
+
+template <typename W>
+BasicSearchWorkspace<W>& BasicSearchWorkspace<W>::Reverse() {
+  if (reverse_ == nullptr) reverse_ = std::make_unique<BasicSearchWorkspace>();
+  return *reverse_;
+}
+
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicSearchWorkspace)
+
+}  // namespace s21
@@ -0,0 +1,86 @@
+#ifndef SRC_GRAPH_ALGORITHMS_S21_SEARCH_WORKSPACE_H_
+#define SRC_GRAPH_ALGORITHMS_S21_SEARCH_WORKSPACE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../graph/s21_graph.h"
+#include "s21_bucket_queues.h"
+#include "s21_indexed_heap.h"
+
+namespace s21 {
+
+// Scratch memory of the graph searches, kept between calls so that a
+// search on a graph no larger than the ones before allocates nothing.
+// Visited and reached flags are epoch stamps: Reset starts a new epoch
+// instead of clearing them. A workspace serves one search at a time, so
+// every thread needs its own.
+template <typename W>
+class BasicSearchWorkspace {
+ public:
+  using weight_type = W;
+  using distance_type = typename BasicGraph<W>::distance_type;
+
+  // The workspace of the calling thread, used by the searches that are
+  // not given one.
+  static BasicSearchWorkspace& ForThisThread();
+
+  // Starts a search over vertices vertices: nothing is visited or reached
+  // and the frontier and the heap are empty.
+  void Reset(std::size_t vertices);
+
+  bool IsVisited(std::size_t v) const { return visited_[v] == epoch_; }
+  void Visit(std::size_t v) { visited_[v] = epoch_; }
+
+  // Tentative distances; Distance(v) is only meaningful once v is reached.
+  // Searches without distances may mark vertices reached with Reach, e.g.
+  // the backward half of a bidirectional search.
+  bool IsReached(std::size_t v) const { return reached_[v] == epoch_; }
+  void Reach(std::size_t v) { reached_[v] = epoch_; }
+  distance_type Distance(std::size_t v) const { return distances_[v]; }
+  void SetDistance(std::size_t v, distance_type distance) {
+    reached_[v] = epoch_;
+    distances_[v] = distance;
+  }
+
+  // Search tree links, only meaningful for vertices set this search.
+  std::size_t Parent(std::size_t v) const { return parents_[v]; }
+  void SetParent(std::size_t v, std::size_t parent) { parents_[v] = parent; }
+
+  // A stack or queue of vertices, a second one for searches running from
+  // both ends, and a heap of vertices by distance.
+  std::vector<std::size_t>& Frontier() { return frontier_; }
+  std::vector<std::size_t>& ReverseFrontier() { return reverse_frontier_; }
+  IndexedHeap<distance_type>& Heap() { return heap_; }
+  // Monotone queues for integer weights, reset by the search using them.
+  BucketQueue& Buckets() { return buckets_; }
+  RadixHeap& Radix() { return radix_; }
+
+  // A workspace of its own for the backward half of a bidirectional
+  // search, made on first use.
+  BasicSearchWorkspace& Reverse();
+
+ private:
+  std::uint32_t epoch_ = 0;
+  std::vector<std::uint32_t> visited_;
+  std::vector<std::uint32_t> reached_;
+  std::vector<distance_type> distances_;
+  std::vector<std::size_t> parents_;
+  std::vector<std::size_t> frontier_;
+  std::vector<std::size_t> reverse_frontier_;
+  IndexedHeap<distance_type> heap_;
+  BucketQueue buckets_;
+  RadixHeap radix_;
+  std::unique_ptr<BasicSearchWorkspace> reverse_;
+};
+
+using SearchWorkspace = BasicSearchWorkspace<int>;
+
+S21_DECLARE_FOR_CELL_TYPES(BasicSearchWorkspace)
+
+}  // namespace s21
+
+#endif  // SRC_GRAPH_ALGORITHMS_S21_SEARCH_WORKSPACE_H_
@@ -0,0 +1,49 @@
+#include "s21_bit_matrix.h"
+
+namespace s21 {
+
+BitMatrix::BitMatrix(std::size_t rows, std::size_t cols)
+    : rows_(rows),
+      cols_(cols),
+      words_per_row_((cols + kWordBits - 1) / kWordBits),
+      words_(rows * words_per_row_, 0) {}
+
+std::size_t BitMatrix::GetRows() const { return rows_; }
+
+std::size_t BitMatrix::GetColumns() const { return cols_; }
+
+std::size_t BitMatrix::GetWordsPerRow() const { return words_per_row_; }
+
+bool BitMatrix::Test(std::size_t i, std::size_t j) const {
+  if (i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Test: i or j is out of range");
+  }
+  return (Row(i)[j / kWordBits] >> (j % kWordBits)) & 1;
+}
+
+void BitMatrix::Set(std::size_t i, std::size_t j, bool value) {
+  if (i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Set: i or j is out of range");
+  }
+  word_type const bit = word_type(1) << (j % kWordBits);
+  if (value) {
+    Row(i)[j / kWordBits] |= bit;
+  } else {
+    Row(i)[j / kWordBits] &= ~bit;
+  }
+}
+
+BitMatrix::word_type* BitMatrix::Row(std::size_t i) {
+  return words_.data() + i * words_per_row_;
+}
+
+const BitMatrix::word_type* BitMatrix::Row(std::size_t i) const {
+  return words_.data() + i * words_per_row_;
+}
+
+bool BitMatrix::operator==(const BitMatrix& other) const {
+  return rows_ == other.rows_ && cols_ == other.cols_ &&
+         words_ == other.words_;
+}
+
+}  // namespace s21
@@ -0,0 +1,44 @@
+#ifndef SRC_MATRIX_S21_BIT_MATRIX_H_
+#define SRC_MATRIX_S21_BIT_MATRIX_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace s21 {
+
+// Boolean matrix packed one bit per cell: row i is GetWordsPerRow() 64-bit
+// words, cell (i, j) is bit j % 64 of word j / 64. The padding bits past
+// the last column are always zero, so rows can be combined word by word.
+class BitMatrix {
+ public:
+  using word_type = std::uint64_t;
+  static constexpr std::size_t kWordBits = 64;
+
+  BitMatrix() = default;
+  BitMatrix(std::size_t rows, std::size_t cols);
+
+  std::size_t GetRows() const;
+  std::size_t GetColumns() const;
+  std::size_t GetWordsPerRow() const;
+
+  bool Test(std::size_t i, std::size_t j) const;
+  void Set(std::size_t i, std::size_t j, bool value = true);
+
+  // Unchecked access to the words of row i.
+  word_type* Row(std::size_t i);
+  const word_type* Row(std::size_t i) const;
+
+  bool operator==(const BitMatrix& other) const;
+
+  // Index of the lowest set bit of a non-zero word.
+  static int LowestBit(word_type word) { return __builtin_ctzll(word); }
+
+ private:
+  std::size_t rows_ = 0, cols_ = 0, words_per_row_ = 0;
+  std::vector<word_type> words_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_MATRIX_S21_BIT_MATRIX_H_
@@ -0,0 +1,275 @@
+#include "s21_csr_matrix.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace s21 {
+
+template <typename T>
+BasicCsrMatrix<T>::BasicCsrMatrix(const BasicMatrix<T>& matrix)
+    : rows_(matrix.GetRows()), cols_(matrix.GetColumns()) {
+  CheckColumns();
+  Arrays arrays;
+  arrays.offsets.assign(rows_ + 1, 0);
+  for (std::size_t i = 0; i < rows_; i++) {
+    const T* row = matrix.Row(i);
+    std::size_t non_zeros = 0;
+    for (std::size_t j = 0; j < cols_; j++) {
+      if (row[j] != 0) non_zeros++;
+    }
+    arrays.offsets[i + 1] = arrays.offsets[i] + non_zeros;
+  }
+  arrays.columns.resize(arrays.offsets[rows_]);
+  arrays.values.resize(arrays.offsets[rows_]);
+  for (std::size_t i = 0; i < rows_; i++) {
+    const T* row = matrix.Row(i);
+    std::size_t k = arrays.offsets[i];
+    for (std::size_t j = 0; j < cols_; j++) {
+      if (row[j] != 0) {
+        arrays.columns[k] = static_cast<index_type>(j);
+        arrays.values[k] = row[j];
+        k++;
+      }
+    }
+  }
+  Own(std::move(arrays));
+}
+
+template <typename T>
+BasicCsrMatrix<T>::BasicCsrMatrix(std::size_t rows, std::size_t cols,
+                                  std::vector<std::size_t> offsets,
+                                  std::vector<index_type> columns,
+                                  std::vector<T> values)
+    : rows_(rows), cols_(cols) {
+  CheckColumns();
+  if (offsets.size() != rows_ + 1 || columns.size() != values.size() ||
+      offsets.back() != columns.size()) {
+    throw std::invalid_argument("CsrMatrix: inconsistent array sizes");
+  }
+  Own({std::move(offsets), std::move(columns), std::move(values)});
+  Validate();
+}
+
+template <typename T>
+BasicCsrMatrix<T>::BasicCsrMatrix(std::size_t rows, std::size_t cols,
+                                  const std::size_t* offsets,
+                                  const index_type* columns, T* values,
+                                  std::shared_ptr<void> owner)
+    : rows_(rows),
+      cols_(cols),
+      offsets_(offsets),
+      columns_(columns),
+      values_(values),
+      owner_(std::move(owner)) {
+  CheckColumns();
+  if (offsets_ == nullptr || owner_ == nullptr) {
+    throw std::invalid_argument("CsrMatrix: invalid external storage");
+  }
+  Validate();
+}
+
+template <typename T>
+BasicCsrMatrix<T>::BasicCsrMatrix(const BasicCsrMatrix& other)
+    : rows_(other.rows_), cols_(other.cols_) {
+  if (other.offsets_ != nullptr) {
+    std::size_t const non_zeros = other.GetNonZeros();
+    Own({std::vector<std::size_t>(other.offsets_,
+                                  other.offsets_ + rows_ + 1),
+         std::vector<index_type>(other.columns_, other.columns_ + non_zeros),
+         std::vector<T>(other.values_, other.values_ + non_zeros)});
+  }
+}
+
+template <typename T>
+BasicCsrMatrix<T>::BasicCsrMatrix(BasicCsrMatrix&& other) {
+  Swap(&other);
+}
+
+template <typename T>
+BasicCsrMatrix<T>& BasicCsrMatrix<T>::operator=(const BasicCsrMatrix& other) {
+  if (this != &other) {
+    BasicCsrMatrix(other).Swap(this);
+  }
+  return *this;
+}
+
+template <typename T>
+BasicCsrMatrix<T>& BasicCsrMatrix<T>::operator=(BasicCsrMatrix&& other) {
+  if (this != &other) {
+    BasicCsrMatrix(std::move(other)).Swap(this);
+  }
+  return *this;
+}
+
+template <typename T>
+void BasicCsrMatrix<T>::Swap(BasicCsrMatrix* other) {
+  std::swap(rows_, other->rows_);
+  std::swap(cols_, other->cols_);
+  std::swap(offsets_, other->offsets_);
+  std::swap(columns_, other->columns_);
+  std::swap(values_, other->values_);
+  std::swap(owner_, other->owner_);
+}
+
+template <typename T>
+std::size_t BasicCsrMatrix<T>::GetRows() const { return rows_; }
+
+template <typename T>
+std::size_t BasicCsrMatrix<T>::GetColumns() const { return cols_; }
+
+template <typename T>
+std::size_t BasicCsrMatrix<T>::GetNonZeros() const {
+  return offsets_ == nullptr ? 0 : offsets_[rows_];
+}
+
+template <typename T>
+std::size_t BasicCsrMatrix<T>::RowBegin(std::size_t i) const {
+  if (i >= rows_) {
+    throw std::out_of_range("RowBegin: i is out of range");
+  }
+  return offsets_[i];
+}
+
+template <typename T>
+std::size_t BasicCsrMatrix<T>::RowEnd(std::size_t i) const {
+  if (i >= rows_) {
+    throw std::out_of_range("RowEnd: i is out of range");
+  }
+  return offsets_[i + 1];
+}
+
+template <typename T>
+const std::size_t* BasicCsrMatrix<T>::Offsets() const { return offsets_; }
+
+template <typename T>
+const typename BasicCsrMatrix<T>::index_type* BasicCsrMatrix<T>::Columns()
+    const {
+  return columns_;
+}
+
+template <typename T>
+const T* BasicCsrMatrix<T>::Values() const { return values_; }
+
+template <typename T>
+T* BasicCsrMatrix<T>::Find(std::size_t i, std::size_t j) {
+  return const_cast<T*>(
+      const_cast<const BasicCsrMatrix*>(this)->Find(i, j));
+}
+
+template <typename T>
+const T* BasicCsrMatrix<T>::Find(std::size_t i, std::size_t j) const {
+  if (i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Find: i or j is out of range");
+  }
+  const index_type* first = columns_ + offsets_[i];
+  const index_type* last = columns_ + offsets_[i + 1];
+  const index_type* it =
+      std::lower_bound(first, last, static_cast<index_type>(j));
+  if (it == last || *it != j) return nullptr;
+  return values_ + (it - columns_);
+}
+
+template <typename T>
+void BasicCsrMatrix<T>::Insert(std::size_t i, std::size_t j, T value) {
+  if (Find(i, j) != nullptr) {
+    throw std::invalid_argument("Insert: the cell is already stored");
+  }
+  std::size_t const non_zeros = GetNonZeros();
+  const index_type* first = columns_ + offsets_[i];
+  const index_type* last = columns_ + offsets_[i + 1];
+  std::size_t const k = static_cast<std::size_t>(
+      std::lower_bound(first, last, static_cast<index_type>(j)) - columns_);
+
+  Arrays arrays;
+  arrays.offsets.assign(offsets_, offsets_ + rows_ + 1);
+  for (std::size_t row = i + 1; row <= rows_; row++) arrays.offsets[row]++;
+  arrays.columns.reserve(non_zeros + 1);
+  arrays.columns.insert(arrays.columns.end(), columns_, columns_ + k);
+  arrays.columns.push_back(static_cast<index_type>(j));
+  arrays.columns.insert(arrays.columns.end(), columns_ + k,
+                        columns_ + non_zeros);
+  arrays.values.reserve(non_zeros + 1);
+  arrays.values.insert(arrays.values.end(), values_, values_ + k);
+  arrays.values.push_back(value);
+  arrays.values.insert(arrays.values.end(), values_ + k, values_ + non_zeros);
+  Own(std::move(arrays));
+}
+
+template <typename T>
+void BasicCsrMatrix<T>::Erase(std::size_t i, std::size_t j) {
+  const T* cell = Find(i, j);
+  if (cell == nullptr) {
+    throw std::invalid_argument("Erase: the cell is not stored");
+  }
+  std::size_t const non_zeros = GetNonZeros();
+  std::size_t const k = static_cast<std::size_t>(cell - values_);
+
+  Arrays arrays;
+  arrays.offsets.assign(offsets_, offsets_ + rows_ + 1);
+  for (std::size_t row = i + 1; row <= rows_; row++) arrays.offsets[row]--;
+  arrays.columns.reserve(non_zeros - 1);
+  arrays.columns.insert(arrays.columns.end(), columns_, columns_ + k);
+  arrays.columns.insert(arrays.columns.end(), columns_ + k + 1,
+                        columns_ + non_zeros);
+  arrays.values.reserve(non_zeros - 1);
+  arrays.values.insert(arrays.values.end(), values_, values_ + k);
+  arrays.values.insert(arrays.values.end(), values_ + k + 1,
+                       values_ + non_zeros);
+  Own(std::move(arrays));
+}
+
+template <typename T>
+BasicMatrix<T> BasicCsrMatrix<T>::ToMatrix() const {
+  if (rows_ == 0 || cols_ == 0) return BasicMatrix<T>();
+  BasicMatrix<T> m(rows_, cols_);
+  for (std::size_t i = 0; i < rows_; i++) {
+    T* row = m.Row(i);
+    for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; k++) {
+      row[columns_[k]] = values_[k];
+    }
+  }
+  return m;
+}
+
+template <typename T>
+void BasicCsrMatrix<T>::Own(Arrays arrays) {
+  auto storage = std::make_shared<Arrays>(std::move(arrays));
+  offsets_ = storage->offsets.data();
+  columns_ = storage->columns.data();
+  values_ = storage->values.data();
+  owner_ = std::move(storage);
+}
+
+template <typename T>
+void BasicCsrMatrix<T>::CheckColumns() const {
+  if (cols_ > std::numeric_limits<index_type>::max()) {
+    throw std::length_error("CsrMatrix: too many columns");
+  }
+}
+
+template <typename T>
+void BasicCsrMatrix<T>::Validate() const {
+  if (offsets_[0] != 0) {
+    throw std::invalid_argument("CsrMatrix: offsets must start with 0");
+  }
+  for (std::size_t i = 0; i < rows_; i++) {
+    if (offsets_[i] > offsets_[i + 1]) {
+      throw std::invalid_argument("CsrMatrix: offsets must not decrease");
+    }
+    for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; k++) {
+      if (columns_[k] >= cols_ ||
+          (k > offsets_[i] && columns_[k - 1] >= columns_[k])) {
+        throw std::invalid_argument(
+            "CsrMatrix: columns must be sorted, unique and in range");
+      }
+      if (values_[k] == 0) {
+        throw std::invalid_argument(
+            "CsrMatrix: stored values must be non-zero");
+      }
+    }
+  }
+}
+
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicCsrMatrix)
+
+}  // namespace s21
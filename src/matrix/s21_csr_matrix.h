@@ -0,0 +1,104 @@
+#ifndef SRC_MATRIX_S21_CSR_MATRIX_H_
+#define SRC_MATRIX_S21_CSR_MATRIX_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Compressed sparse row matrix: only non-zero cells are stored. Row i owns
+// the cells [offsets[i], offsets[i + 1]) of the columns/values arrays,
+// columns inside a row are sorted in ascending order.
+template <typename T>
+class BasicCsrMatrix {
+ public:
+  using index_type = std::uint32_t;
+  using value_type = T;
+
+  BasicCsrMatrix() = default;
+  explicit BasicCsrMatrix(const BasicMatrix<T>& matrix);
+  BasicCsrMatrix(std::size_t rows, std::size_t cols,
+                 std::vector<std::size_t> offsets,
+                 std::vector<index_type> columns, std::vector<T> values);
+  // Wraps external arrays like BasicMatrix; they are checked like the
+  // vectors above.
+  BasicCsrMatrix(std::size_t rows, std::size_t cols,
+                 const std::size_t* offsets, const index_type* columns,
+                 T* values, std::shared_ptr<void> owner);
+  BasicCsrMatrix(const BasicCsrMatrix& other);
+  BasicCsrMatrix(BasicCsrMatrix&& other);
+  ~BasicCsrMatrix() = default;
+
+  BasicCsrMatrix& operator=(const BasicCsrMatrix& other);
+  BasicCsrMatrix& operator=(BasicCsrMatrix&& other);
+
+  void Swap(BasicCsrMatrix* other);
+
+  std::size_t GetRows() const;
+  std::size_t GetColumns() const;
+  std::size_t GetNonZeros() const;
+
+  std::size_t RowBegin(std::size_t i) const;
+  std::size_t RowEnd(std::size_t i) const;
+  const std::size_t* Offsets() const;
+  const index_type* Columns() const;
+  const T* Values() const;
+
+  // Calls function(j, value) for every stored cell of row i, by column.
+  template <typename Function>
+  void ForEachInRow(std::size_t i, Function&& function) const;
+
+  // Find, Insert and Erase throw std::out_of_range for a cell outside
+  // the matrix.
+  T* Find(std::size_t i, std::size_t j);
+  const T* Find(std::size_t i, std::size_t j) const;
+
+  // Add the cell (i, j), which must not be stored yet, or remove it. Both
+  // rebuild the arrays in O(non-zeros), so they suit occasional updates,
+  // not building a matrix cell by cell.
+  void Insert(std::size_t i, std::size_t j, T value);
+  void Erase(std::size_t i, std::size_t j);
+
+  BasicMatrix<T> ToMatrix() const;
+
+ private:
+  struct Arrays {
+    std::vector<std::size_t> offsets;
+    std::vector<index_type> columns;
+    std::vector<T> values;
+  };
+
+  std::size_t rows_ = 0, cols_ = 0;
+  const std::size_t* offsets_ = nullptr;
+  const index_type* columns_ = nullptr;
+  T* values_ = nullptr;
+  std::shared_ptr<void> owner_;
+
+  void Own(Arrays arrays);
+  // Throws std::length_error unless every column fits index_type.
+  void CheckColumns() const;
+  // Throws std::invalid_argument unless the offsets start with 0 and do
+  // not decrease, the columns of every row are sorted, unique and in range
+  // and no stored value is zero.
+  void Validate() const;
+};
+
+using CsrMatrix = BasicCsrMatrix<int>;
+
+S21_DECLARE_FOR_CELL_TYPES(BasicCsrMatrix)
+
+template <typename T>
+template <typename Function>
+void BasicCsrMatrix<T>::ForEachInRow(std::size_t i,
+                                     Function&& function) const {
+  for (std::size_t k = RowBegin(i), end = RowEnd(i); k < end; k++) {
+    function(std::size_t(columns_[k]), values_[k]);
+  }
+}
+
+}  // namespace s21
+
+#endif  // SRC_MATRIX_S21_CSR_MATRIX_H_
@@ -1,227 +1,307 @@
 #include "s21_matrix_oop.h"
 
+#include <new>
+
 namespace s21 {
 
-Matrix::Matrix(std::size_t rows, std::size_t cols) : rows_(rows), cols_(cols) {
+template <typename T>
+BasicMatrix<T>::BasicMatrix(std::size_t rows, std::size_t cols)
+    : rows_(rows), cols_(cols) {
   if (rows == 0 || cols == 0) {
     throw std::invalid_argument("Matrix: rows and columns must be more than 0");
   }
 
-  matrix_ = new int*[rows_];
+  // Rows are padded to the cache line size, so every row is aligned.
+  std::size_t const row_alignment = kAlignment / sizeof(T);
+  if (cols_ > SIZE_MAX - (row_alignment - 1)) {
+    throw std::length_error("Matrix: too many columns");
+  }
+  stride_ = (cols_ + row_alignment - 1) / row_alignment * row_alignment;
+  matrix_ = Allocate(rows_, stride_);
+  std::memset(matrix_, 0, rows_ * stride_ * sizeof(T));
+}
 
-  for (std::size_t i = 0; i < rows_; i++) {
-    matrix_[i] = new int[cols_]();
+template <typename T>
+BasicMatrix<T>::BasicMatrix(std::size_t rows, std::size_t cols,
+                            std::size_t stride, T* cells,
+                            std::shared_ptr<void> owner)
+    : rows_(rows),
+      cols_(cols),
+      stride_(stride),
+      matrix_(cells),
+      owner_(std::move(owner)) {
+  if (rows == 0 || cols == 0 || stride < cols || cells == nullptr ||
+      owner_ == nullptr) {
+    throw std::invalid_argument("Matrix: invalid external storage");
   }
 }
 
-Matrix::Matrix(const Matrix& other) {
+template <typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix& other) {
   if (other.rows_ > 0 && other.cols_ > 0) {
-    Matrix m(other.rows_, other.cols_);
-    for (std::size_t i = 0; i < m.rows_; i++) {
-      std::memcpy(m.matrix_[i], other.matrix_[i], other.cols_ * sizeof(int));
-    }
-    Swap(&m);
+    matrix_ = Allocate(other.rows_, other.stride_);
+    std::memcpy(matrix_, other.matrix_,
+                other.rows_ * other.stride_ * sizeof(T));
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    stride_ = other.stride_;
   }
 }
 
-Matrix::Matrix(Matrix&& other) { Swap(&other); }
+template <typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrix&& other) {
+  Swap(&other);
+}
 
-Matrix::~Matrix() {
-  if (matrix_ != nullptr) {
-    for (std::size_t i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
-    matrix_ = nullptr;
+template <typename T>
+BasicMatrix<T>::~BasicMatrix() {
+  if (owner_ == nullptr) {
+    ::operator delete(matrix_, std::align_val_t(kAlignment));
   }
+  owner_.reset();
+  matrix_ = nullptr;
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
+}
+
+template <typename T>
+T* BasicMatrix<T>::Allocate(std::size_t rows, std::size_t stride) {
+  if (rows > (SIZE_MAX - (kAlignment - 1)) / stride / sizeof(T)) {
+    throw std::length_error("Matrix: too many cells");
+  }
+  std::size_t size = rows * stride * sizeof(T);
+  size = (size + kAlignment - 1) / kAlignment * kAlignment;
+  return static_cast<T*>(::operator new(size, std::align_val_t(kAlignment)));
 }
 
-void Matrix::Swap(Matrix* other) {
+template <typename T>
+void BasicMatrix<T>::Swap(BasicMatrix* other) {
   std::swap(rows_, other->rows_);
   std::swap(cols_, other->cols_);
+  std::swap(stride_, other->stride_);
   std::swap(matrix_, other->matrix_);
+  std::swap(owner_, other->owner_);
 }
 
-std::size_t Matrix::GetRows() const { return rows_; }
+template <typename T>
+std::size_t BasicMatrix<T>::GetRows() const { return rows_; }
 
-void Matrix::SetRows(std::size_t rows) {
+template <typename T>
+void BasicMatrix<T>::SetRows(std::size_t rows) {
   if (rows_ != rows) {
-    Matrix m(rows, cols_);
+    BasicMatrix m(rows, cols_);
     for (std::size_t i = 0; i < std::min(rows_, rows); i++) {
-      std::memcpy(m.matrix_[i], matrix_[i], cols_ * sizeof(int));
+      std::memcpy(m.Row(i), Row(i), cols_ * sizeof(T));
     }
     Swap(&m);
   }
 }
 
-std::size_t Matrix::GetColumns() const { return cols_; }
+template <typename T>
+std::size_t BasicMatrix<T>::GetColumns() const { return cols_; }
 
-void Matrix::SetColumns(std::size_t cols) {
+template <typename T>
+void BasicMatrix<T>::SetColumns(std::size_t cols) {
   if (cols_ != cols) {
-    Matrix m(rows_, cols);
+    BasicMatrix m(rows_, cols);
     auto const length = std::min(cols_, cols);
     for (std::size_t i = 0; i < rows_; i++) {
-      std::memcpy(m.matrix_[i], matrix_[i], length * sizeof(int));
+      std::memcpy(m.Row(i), Row(i), length * sizeof(T));
     }
     Swap(&m);
   }
 }
 
-bool Matrix::EqMatrix(const Matrix& other) const {
+template <typename T>
+std::size_t BasicMatrix<T>::GetStride() const { return stride_; }
+
+template <typename T>
+T* BasicMatrix<T>::Row(std::size_t i) { return matrix_ + i * stride_; }
+
+template <typename T>
+const T* BasicMatrix<T>::Row(std::size_t i) const {
+  return matrix_ + i * stride_;
+}
+
+template <typename T>
+bool BasicMatrix<T>::EqMatrix(const BasicMatrix& other) const {
   if (rows_ != other.rows_ || cols_ != other.cols_) return false;
   if (rows_ == 0 || cols_ == 0) {
     throw std::logic_error("EqMatrix: invalid matrix");
   }
   for (std::size_t i = 0; i < rows_; i++) {
-    for (std::size_t j = 0; j < cols_; j++) {
-      if (matrix_[i][j] != other.matrix_[i][j]) return false;
+    if constexpr (std::is_floating_point_v<T>) {
+      for (std::size_t j = 0; j < cols_; j++) {
+        if (std::fabs(Row(i)[j] - other.Row(i)[j]) > kEps) return false;
+      }
+    } else if (std::memcmp(Row(i), other.Row(i), cols_ * sizeof(T)) != 0) {
+      return false;
     }
   }
   return true;
 }
 
-void Matrix::SumMatrix(const Matrix& other) {
+template <typename T>
+void BasicMatrix<T>::SumMatrix(const BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_ || rows_ == 0 ||
       cols_ == 0) {
     throw std::logic_error(
         "SumMatrix: invalid matrix or different dimensions of the matrix");
   }
   for (std::size_t i = 0; i < rows_; i++) {
+    T* row = Row(i);
+    const T* other_row = other.Row(i);
     for (std::size_t j = 0; j < cols_; j++) {
-      matrix_[i][j] += other.matrix_[i][j];
+      row[j] = static_cast<T>(row[j] + other_row[j]);
     }
   }
 }
 
-void Matrix::SubMatrix(const Matrix& other) {
+template <typename T>
+void BasicMatrix<T>::SubMatrix(const BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_ || rows_ == 0 ||
       cols_ == 0) {
     throw std::logic_error(
         "SubMatrix: invalid matrix or different dimensions of the matrix");
   }
   for (std::size_t i = 0; i < rows_; i++) {
+    T* row = Row(i);
+    const T* other_row = other.Row(i);
     for (std::size_t j = 0; j < cols_; j++) {
-      matrix_[i][j] -= other.matrix_[i][j];
+      row[j] = static_cast<T>(row[j] - other_row[j]);
     }
   }
 }
 
-void Matrix::MulNumber(int number) {
+template <typename T>
+void BasicMatrix<T>::MulNumber(T number) {
   if (rows_ == 0 || cols_ == 0) {
     throw std::logic_error("MulNumber: invalid matrix");
   }
   for (std::size_t i = 0; i < rows_; i++) {
+    T* row = Row(i);
     for (std::size_t j = 0; j < cols_; j++) {
-      matrix_[i][j] *= number;
+      row[j] = static_cast<T>(row[j] * number);
     }
   }
 }
 
-void Matrix::MulMatrix(const Matrix& other) {
+template <typename T>
+void BasicMatrix<T>::MulMatrix(const BasicMatrix& other) {
   if (cols_ != other.rows_ || rows_ == 0 || cols_ == 0 || other.rows_ == 0 ||
       other.cols_ == 0) {
     throw std::logic_error(
         "MulMatrix: invalid matrix or different dimensions of the matrix");
   }
-  Matrix m(rows_, other.cols_);
+  BasicMatrix m(rows_, other.cols_);
   for (std::size_t i = 0; i < m.rows_; i++) {
-    for (std::size_t j = 0; j < m.cols_; j++) {
-      for (std::size_t k = 0; k < cols_; k++) {
-        m.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
+    T* result_row = m.Row(i);
+    for (std::size_t k = 0; k < cols_; k++) {
+      T const factor = Row(i)[k];
+      const T* other_row = other.Row(k);
+      for (std::size_t j = 0; j < m.cols_; j++) {
+        result_row[j] = static_cast<T>(result_row[j] + factor * other_row[j]);
       }
     }
   }
   Swap(&m);
 }
 
-Matrix Matrix::Transpose() const {
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::Transpose() const {
   if (rows_ == 0 || cols_ == 0) {
     throw std::logic_error("Transpose: invalid matrix");
   }
-  Matrix m(cols_, rows_);
+  BasicMatrix m(cols_, rows_);
   for (std::size_t i = 0; i < m.rows_; i++) {
     for (std::size_t j = 0; j < m.cols_; j++) {
-      m.matrix_[i][j] = matrix_[j][i];
+      m.Row(i)[j] = Row(j)[i];
     }
   }
   return m;
 }
 
-Matrix Matrix::operator+(const Matrix& other) const {
-  Matrix m(*this);
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::operator+(const BasicMatrix& other) const {
+  BasicMatrix m(*this);
   m.SumMatrix(other);
   return m;
 }
 
-Matrix Matrix::operator-(const Matrix& other) const {
-  Matrix m(*this);
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::operator-(const BasicMatrix& other) const {
+  BasicMatrix m(*this);
   m.SubMatrix(other);
   return m;
 }
 
-Matrix Matrix::operator*(const Matrix& other) const {
-  Matrix m(*this);
+template <typename T>
+BasicMatrix<T> BasicMatrix<T>::operator*(const BasicMatrix& other) const {
+  BasicMatrix m(*this);
   m.MulMatrix(other);
   return m;
 }
 
-Matrix operator*(Matrix const& self, int number) {
-  Matrix m(self);
-  m.MulNumber(number);
-  return m;
-}
-
-Matrix operator*(int number, Matrix const& self) {
-  return operator*(self, number);
+template <typename T>
+bool BasicMatrix<T>::operator==(const BasicMatrix& other) const {
+  return EqMatrix(other);
 }
 
-bool Matrix::operator==(const Matrix& other) const { return EqMatrix(other); }
-
-Matrix& Matrix::operator=(const Matrix& other) {
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const BasicMatrix& other) {
   if (this != &other) {
-    Matrix(other).Swap(this);
+    BasicMatrix(other).Swap(this);
   }
   return *this;
 }
 
-Matrix& Matrix::operator=(Matrix&& other) {
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(BasicMatrix&& other) {
   if (this != &other) {
-    Matrix(std::move(other)).Swap(this);
+    BasicMatrix(std::move(other)).Swap(this);
   }
   return *this;
 }
 
-Matrix& Matrix::operator+=(const Matrix& other) {
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
 
-Matrix& Matrix::operator-=(const Matrix& other) {
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator-=(const BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
 
-Matrix& Matrix::operator*=(const Matrix& other) {
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(const BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
 
-Matrix& Matrix::operator*=(int number) {
+template <typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(T number) {
   MulNumber(number);
   return *this;
 }
 
-int& Matrix::operator()(std::size_t i, std::size_t j) {
-  return const_cast<int&>(const_cast<const Matrix*>(this)->operator()(i, j));
+template <typename T>
+T& BasicMatrix<T>::operator()(std::size_t i, std::size_t j) {
+  return const_cast<T&>(
+      const_cast<const BasicMatrix*>(this)->operator()(i, j));
 }
 
-int const& Matrix::operator()(std::size_t i, std::size_t j) const {
+template <typename T>
+const T& BasicMatrix<T>::operator()(std::size_t i, std::size_t j) const {
   if (i >= rows_ || j >= cols_) {
     throw std::out_of_range("operator(): i or j is out of range");
   }
-  return matrix_[i][j];
+  return matrix_[i * stride_ + j];
 }
 
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicMatrix)
+
 }  // namespace s21
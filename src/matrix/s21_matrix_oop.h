@@ -2,56 +2,104 @@
 #define SRC_MATRIX_S21_MATRIX_OOP_H_
 
 #include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <string_view>
+#include <type_traits>
+
+// Calls X(arg, T) for every cell type T the matrix and graph templates are
+// explicitly instantiated for; S21_FOR_EACH_CELL_TYPE calls X(T).
+#define S21_FOR_EACH_CELL_TYPE_WITH(X, arg) \
+  X(arg, std::int16_t) X(arg, int) X(arg, float) X(arg, double)
+#define S21_CALL_WITH_CELL_TYPE(X, T) X(T)
+#define S21_FOR_EACH_CELL_TYPE(X) \
+  S21_FOR_EACH_CELL_TYPE_WITH(S21_CALL_WITH_CELL_TYPE, X)
+
+// Explicit instantiations of a class template for the cell types, in its
+// source file, and their declarations, in its header.
+#define S21_INSTANTIATE_CLASS_FOR(Class, T) template class Class<T>;
+#define S21_DECLARE_CLASS_FOR(Class, T) extern template class Class<T>;
+#define S21_INSTANTIATE_FOR_CELL_TYPES(Class) \
+  S21_FOR_EACH_CELL_TYPE_WITH(S21_INSTANTIATE_CLASS_FOR, Class)
+#define S21_DECLARE_FOR_CELL_TYPES(Class) \
+  S21_FOR_EACH_CELL_TYPE_WITH(S21_DECLARE_CLASS_FOR, Class)
 
 namespace s21 {
 
-class Matrix {
+// Dense matrix of T cells.
+template <typename T>
+class BasicMatrix {
  public:
-  Matrix() = default;
-  Matrix(std::size_t rows, std::size_t cols);
-  Matrix(const Matrix& other);
-  Matrix(Matrix&& other);
-  ~Matrix();
+  using value_type = T;
 
-  void Swap(Matrix* other);
+  BasicMatrix() = default;
+  BasicMatrix(std::size_t rows, std::size_t cols);
+  // Wraps cells that live in external memory (e.g. a mapped file) without
+  // copying them; owner keeps that memory alive. Copies are always owning.
+  BasicMatrix(std::size_t rows, std::size_t cols, std::size_t stride,
+              T* cells, std::shared_ptr<void> owner);
+  BasicMatrix(const BasicMatrix& other);
+  BasicMatrix(BasicMatrix&& other);
+  ~BasicMatrix();
+
+  void Swap(BasicMatrix* other);
 
   std::size_t GetRows() const;
   void SetRows(std::size_t rows);
   std::size_t GetColumns() const;
   void SetColumns(std::size_t cols);
+  std::size_t GetStride() const;
+
+  // Unchecked access to the row storage for hot loops: row i starts at
+  // Row(i) and rows are GetStride() cells apart in one contiguous buffer.
+  T* Row(std::size_t i);
+  const T* Row(std::size_t i) const;
 
-  bool EqMatrix(const Matrix& other) const;
-  void SumMatrix(const Matrix& other);
-  void SubMatrix(const Matrix& other);
-  void MulNumber(int number);
-  void MulMatrix(const Matrix& other);
-  Matrix Transpose() const;
-
-  Matrix operator+(const Matrix& other) const;
-  Matrix operator-(const Matrix& other) const;
-  Matrix operator*(const Matrix& other) const;
-  friend Matrix operator*(const Matrix& self, int number);
-  friend Matrix operator*(int number, const Matrix& self);
-  bool operator==(const Matrix& other) const;
-  Matrix& operator=(const Matrix& other);
-  Matrix& operator=(Matrix&& other);
-  Matrix& operator+=(const Matrix& other);
-  Matrix& operator-=(const Matrix& other);
-  Matrix& operator*=(const Matrix& other);
-  Matrix& operator*=(int number);
-  int& operator()(std::size_t i, std::size_t j);
-  const int& operator()(std::size_t i, std::size_t j) const;
+  bool EqMatrix(const BasicMatrix& other) const;
+  void SumMatrix(const BasicMatrix& other);
+  void SubMatrix(const BasicMatrix& other);
+  void MulNumber(T number);
+  void MulMatrix(const BasicMatrix& other);
+  BasicMatrix Transpose() const;
+
+  BasicMatrix operator+(const BasicMatrix& other) const;
+  BasicMatrix operator-(const BasicMatrix& other) const;
+  BasicMatrix operator*(const BasicMatrix& other) const;
+  friend BasicMatrix operator*(const BasicMatrix& self, T number) {
+    BasicMatrix m(self);
+    m.MulNumber(number);
+    return m;
+  }
+  friend BasicMatrix operator*(T number, const BasicMatrix& self) {
+    return self * number;
+  }
+  bool operator==(const BasicMatrix& other) const;
+  BasicMatrix& operator=(const BasicMatrix& other);
+  BasicMatrix& operator=(BasicMatrix&& other);
+  BasicMatrix& operator+=(const BasicMatrix& other);
+  BasicMatrix& operator-=(const BasicMatrix& other);
+  BasicMatrix& operator*=(const BasicMatrix& other);
+  BasicMatrix& operator*=(T number);
+  T& operator()(std::size_t i, std::size_t j);
+  const T& operator()(std::size_t i, std::size_t j) const;
 
  private:
   constexpr static const double kEps = 1e-7;
+  constexpr static const std::size_t kAlignment = 64;
+
+  std::size_t rows_ = 0, cols_ = 0, stride_ = 0;
+  T* matrix_ = nullptr;
+  std::shared_ptr<void> owner_;
 
-  std::size_t rows_ = 0, cols_ = 0;
-  int** matrix_ = nullptr;
+  static T* Allocate(std::size_t rows, std::size_t stride);
 };
 
+using Matrix = BasicMatrix<int>;
+
+S21_DECLARE_FOR_CELL_TYPES(BasicMatrix)
+
 }  // namespace s21
 
 #endif  // SRC_MATRIX_S21_MATRIX_OOP_H_
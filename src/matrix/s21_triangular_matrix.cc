@@ -0,0 +1,148 @@
+#include "s21_triangular_matrix.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+template <typename T>
+BasicTriangularMatrix<T>::BasicTriangularMatrix(std::size_t size)
+    : size_(size) {
+  // PackedSize(size) is halved * other, with the factor 2 taken out of
+  // whichever of size and size + 1 is even, so neither can overflow.
+  if (size_ > 0) {
+    std::size_t const halved = size_ % 2 == 0 ? size_ / 2 : size_;
+    std::size_t const other = size_ % 2 == 0 ? size_ + 1 : size_ / 2 + 1;
+    if (halved > SIZE_MAX / sizeof(T) / other) {
+      throw std::length_error("TriangularMatrix: too many cells");
+    }
+  }
+  Own(std::vector<T>(PackedSize(size_), T(0)));
+}
+
+template <typename T>
+BasicTriangularMatrix<T>::BasicTriangularMatrix(const BasicMatrix<T>& matrix)
+    : size_(matrix.GetRows()) {
+  if (matrix.GetRows() != matrix.GetColumns()) {
+    throw std::invalid_argument("TriangularMatrix: matrix must be square");
+  }
+  std::vector<T> cells;
+  cells.reserve(PackedSize(size_));
+  for (std::size_t i = 0; i < size_; i++) {
+    const T* row = matrix.Row(i);
+    cells.insert(cells.end(), row + i, row + size_);
+  }
+  Own(std::move(cells));
+}
+
+template <typename T>
+BasicTriangularMatrix<T>::BasicTriangularMatrix(std::size_t size, T* cells,
+                                                std::shared_ptr<void> owner)
+    : size_(size), cells_(cells), owner_(std::move(owner)) {
+  if (cells_ == nullptr || owner_ == nullptr) {
+    throw std::invalid_argument("TriangularMatrix: invalid external storage");
+  }
+}
+
+template <typename T>
+BasicTriangularMatrix<T>::BasicTriangularMatrix(
+    const BasicTriangularMatrix& other)
+    : size_(other.size_) {
+  if (other.cells_ != nullptr) {
+    Own(std::vector<T>(other.cells_, other.cells_ + PackedSize(size_)));
+  }
+}
+
+template <typename T>
+BasicTriangularMatrix<T>::BasicTriangularMatrix(BasicTriangularMatrix&& other) {
+  Swap(&other);
+}
+
+template <typename T>
+BasicTriangularMatrix<T>& BasicTriangularMatrix<T>::operator=(
+    const BasicTriangularMatrix& other) {
+  if (this != &other) {
+    BasicTriangularMatrix(other).Swap(this);
+  }
+  return *this;
+}
+
+template <typename T>
+BasicTriangularMatrix<T>& BasicTriangularMatrix<T>::operator=(
+    BasicTriangularMatrix&& other) {
+  if (this != &other) {
+    BasicTriangularMatrix(std::move(other)).Swap(this);
+  }
+  return *this;
+}
+
+template <typename T>
+void BasicTriangularMatrix<T>::Swap(BasicTriangularMatrix* other) {
+  std::swap(size_, other->size_);
+  std::swap(cells_, other->cells_);
+  std::swap(owner_, other->owner_);
+}
+
+template <typename T>
+std::size_t BasicTriangularMatrix<T>::GetSize() const {
+  return size_;
+}
+
+template <typename T>
+std::size_t BasicTriangularMatrix<T>::PackedSize(std::size_t size) {
+  return size * (size + 1) / 2;
+}
+
+template <typename T>
+T* BasicTriangularMatrix<T>::RowTail(std::size_t i) {
+  return cells_ + i * size_ - i * (i - 1) / 2;
+}
+
+template <typename T>
+const T* BasicTriangularMatrix<T>::RowTail(std::size_t i) const {
+  return cells_ + i * size_ - i * (i - 1) / 2;
+}
+
+template <typename T>
+T& BasicTriangularMatrix<T>::operator()(std::size_t i, std::size_t j) {
+  if (i >= size_ || j >= size_) {
+    throw std::out_of_range("operator(): i or j is out of range");
+  }
+  if (i > j) std::swap(i, j);
+  return RowTail(i)[j - i];
+}
+
+template <typename T>
+const T& BasicTriangularMatrix<T>::operator()(std::size_t i,
+                                              std::size_t j) const {
+  if (i >= size_ || j >= size_) {
+    throw std::out_of_range("operator(): i or j is out of range");
+  }
+  if (i > j) std::swap(i, j);
+  return RowTail(i)[j - i];
+}
+
+template <typename T>
+BasicMatrix<T> BasicTriangularMatrix<T>::ToMatrix() const {
+  if (size_ == 0) return BasicMatrix<T>();
+  BasicMatrix<T> m(size_, size_);
+  for (std::size_t i = 0; i < size_; i++) {
+    const T* tail = RowTail(i);
+    T* row = m.Row(i);
+    for (std::size_t j = i; j < size_; j++) {
+      row[j] = tail[j - i];
+      m.Row(j)[i] = tail[j - i];
+    }
+  }
+  return m;
+}
+
+template <typename T>
+void BasicTriangularMatrix<T>::Own(std::vector<T> cells) {
+  auto storage = std::make_shared<std::vector<T>>(std::move(cells));
+  cells_ = storage->data();
+  owner_ = std::move(storage);
+}
+
+S21_INSTANTIATE_FOR_CELL_TYPES(BasicTriangularMatrix)
+
+}  // namespace s21
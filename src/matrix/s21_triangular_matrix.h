@@ -0,0 +1,63 @@
+#ifndef SRC_MATRIX_S21_TRIANGULAR_MATRIX_H_
+#define SRC_MATRIX_S21_TRIANGULAR_MATRIX_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Symmetric square matrix that stores only the upper triangle, diagonal
+// included, packed row by row: row i holds the cells (i, i) .. (i, n - 1)
+// and (i, j) with i > j is the same cell as (j, i). Takes n (n + 1) / 2
+// cells instead of n * n.
+template <typename T>
+class BasicTriangularMatrix {
+ public:
+  using value_type = T;
+
+  BasicTriangularMatrix() = default;
+  explicit BasicTriangularMatrix(std::size_t size);
+  // Packs the upper triangle of a square matrix; the caller makes sure the
+  // matrix is symmetric.
+  explicit BasicTriangularMatrix(const BasicMatrix<T>& matrix);
+  // Wraps external cells like BasicMatrix.
+  BasicTriangularMatrix(std::size_t size, T* cells,
+                        std::shared_ptr<void> owner);
+  BasicTriangularMatrix(const BasicTriangularMatrix& other);
+  BasicTriangularMatrix(BasicTriangularMatrix&& other);
+  ~BasicTriangularMatrix() = default;
+
+  BasicTriangularMatrix& operator=(const BasicTriangularMatrix& other);
+  BasicTriangularMatrix& operator=(BasicTriangularMatrix&& other);
+
+  void Swap(BasicTriangularMatrix* other);
+
+  std::size_t GetSize() const;
+  static std::size_t PackedSize(std::size_t size);
+
+  // Unchecked access to the packed cells: the upper part of row i, that is
+  // the cells (i, i) .. (i, n - 1), starts at RowTail(i).
+  T* RowTail(std::size_t i);
+  const T* RowTail(std::size_t i) const;
+
+  T& operator()(std::size_t i, std::size_t j);
+  const T& operator()(std::size_t i, std::size_t j) const;
+
+  BasicMatrix<T> ToMatrix() const;
+
+ private:
+  std::size_t size_ = 0;
+  T* cells_ = nullptr;
+  std::shared_ptr<void> owner_;
+
+  void Own(std::vector<T> cells);
+};
+
+S21_DECLARE_FOR_CELL_TYPES(BasicTriangularMatrix)
+
+}  // namespace s21
+
+#endif  // SRC_MATRIX_S21_TRIANGULAR_MATRIX_H_
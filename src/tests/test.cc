@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <set>
+#include <thread>
+
+#include "../graph/s21_graph_binary.h"
+#include "../graph/s21_graph_publisher.h"
+#include "../graph/s21_text_parser.h"
 #include "../graph_algorithms/s21_graph_algorithms.h"
 
 void validate_path(const s21::tsm::TsmResult& res, const s21::Graph& graph) {
@@ -17,6 +23,46 @@ void validate_path(const s21::tsm::TsmResult& res, const s21::Graph& graph) {
   EXPECT_DOUBLE_EQ(res.distance, total_distance);
 }
 
+// A complete undirected graph of the given number of cities with
+// weights from 1 to 100.
+s21::Graph randomCompleteGraph(std::size_t cities, unsigned seed) {
+  std::mt19937 weights(seed);
+  s21::Graph graph(cities);
+  for (std::size_t i = 0; i < cities; i++) {
+    for (std::size_t j = i + 1; j < cities; j++) {
+      graph(i, j) = (int)(weights() % 100) + 1;
+      graph(j, i) = graph(i, j);
+    }
+  }
+  return graph;
+}
+
+// Opens the steps of the ant colony to the tests.
+class AntColonySteps : public s21::tsm::AntColony {
+ public:
+  using AntColony::AntColony;
+  using AntColony::Ant;
+  using AntColony::ChooseCity;
+  using AntColony::SimulateAnts;
+  using AntColony::UpdatePheromone;
+
+  // The colony's matrices before the first iteration.
+  template <typename W>
+  static void Prepare(const s21::BasicGraph<W>& graph,
+                      s21::BasicMatrix<float>* proximity,
+                      s21::BasicMatrix<float>* pheromone) {
+    std::size_t const cities = graph.AmountOfVertices();
+    *proximity = s21::BasicMatrix<float>(cities, cities);
+    *pheromone = s21::BasicMatrix<float>(cities, cities);
+    for (std::size_t i = 0; i < cities; i++) {
+      for (std::size_t j = 0; j < cities; j++) {
+        (*pheromone)(i, j) = 0.2f;
+        if (graph(i, j) != 0) (*proximity)(i, j) = 1.f / (float)graph(i, j);
+      }
+    }
+  }
+};
+
 bool findSubstringInFile(const std::string& substr,
                          const std::string& fileName) {
   bool result = false;
@@ -35,6 +81,95 @@ bool findSubstringInFile(const std::string& substr,
   return result;
 }
 
+// Counts heap allocations, so tests can check that code does none, and
+// keeps the largest one, so they can check what was never allocated. The
+// sanitizers bring an operator new of their own, so it is left alone there.
+std::atomic<std::size_t> allocations(0);
+std::atomic<std::size_t> largest_allocation(0);
+
+#ifndef __SANITIZE_ADDRESS__
+#define S21_COUNT_ALLOCATIONS
+
+void CountAllocation(std::size_t size) {
+  allocations++;
+  std::size_t largest = largest_allocation;
+  while (size > largest &&
+         !largest_allocation.compare_exchange_weak(largest, size)) {
+  }
+}
+
+// Not inlined: the compiler would see free() paired with operator new.
+__attribute__((noinline)) void* operator new(std::size_t size) {
+  CountAllocation(size);
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p,
+                                               std::size_t) noexcept {
+  std::free(p);
+}
+
+// Matrix takes its cache line aligned cells from here, in multiples of
+// the alignment.
+__attribute__((noinline)) void* operator new(std::size_t size,
+                                             std::align_val_t alignment) {
+  CountAllocation(size);
+  std::size_t const align = static_cast<std::size_t>(alignment);
+  void* p = std::aligned_alloc(align, size == 0 ? align : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p,
+                                               std::align_val_t) noexcept {
+  std::free(p);
+}
+#endif
+
+// Sparse graph with up to degree random arcs of weight 1 per vertex.
+s21::Graph RandomSparseGraph(std::size_t n, int degree, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::vector<std::size_t> offsets(n + 1, 0);
+  std::vector<s21::CsrMatrix::index_type> columns;
+  for (std::size_t i = 0; i < n; i++) {
+    std::set<s21::CsrMatrix::index_type> row;
+    for (int k = 0; k < degree; k++) {
+      row.insert((s21::CsrMatrix::index_type)vertex(gen));
+    }
+    columns.insert(columns.end(), row.begin(), row.end());
+    offsets[i + 1] = columns.size();
+  }
+  std::vector<int> values(columns.size(), 1);
+  return s21::Graph(s21::CsrMatrix(n, n, offsets, columns, values));
+}
+
+TEST(matrixClass, flatStorage) {
+  s21::Matrix m(3, 5);
+  EXPECT_GE(m.GetStride(), m.GetColumns());
+  EXPECT_EQ(m.Row(1) - m.Row(0), (std::ptrdiff_t)m.GetStride());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(m.Row(2)) % 64, 0);
+
+  for (std::size_t i = 0; i < 3; i++) {
+    for (std::size_t j = 0; j < 5; j++) m.Row(i)[j] = (int)(i * 5 + j);
+  }
+  s21::Matrix copy(m);
+  EXPECT_EQ(copy(2, 4), 14);
+  EXPECT_EQ(copy, m);
+
+  copy.SetColumns(2);
+  copy.SetRows(4);
+  EXPECT_EQ(copy(1, 1), 6);
+  EXPECT_EQ(copy(3, 1), 0);
+  EXPECT_EQ((m * m.Transpose())(0, 0), 30);
+}
+
 TEST(graphClass, stdConstructor) {
   s21::Graph my_graph;
   EXPECT_THROW(my_graph(0, 0), std::out_of_range);
@@ -87,6 +222,19 @@ TEST(graphClass, copyOperator) {
   EXPECT_THROW(my_graph_2(4, 5), std::out_of_range);
 }
 
+TEST(graphClass, movedFromGraphIsEmpty) {
+  s21::Graph my_graph_1(5);
+  s21::Graph my_graph_2;
+  my_graph_2 = std::move(my_graph_1);
+  EXPECT_EQ(my_graph_2.AmountOfVertices(), 5);
+  EXPECT_EQ(my_graph_1.AmountOfVertices(), 0);
+  s21::Graph my_graph_3(std::move(my_graph_2));
+  EXPECT_EQ(my_graph_2.AmountOfVertices(), 0);
+  EXPECT_THROW(my_graph_2(0, 0), std::out_of_range);
+  my_graph_2 = my_graph_3;
+  EXPECT_EQ(my_graph_2.AmountOfVertices(), 5);
+}
+
 TEST(graphClass, moveOperator) {
   s21::Graph my_graph_1(5);
   s21::Graph my_graph_2 = std::move(my_graph_1);
@@ -126,15 +274,113 @@ TEST(graphClass, loadFromFile) {
   }
 }
 
+TEST(graphClass, loadFromFileHugeHeader) {
+  s21::Graph g;
+  EXPECT_THROW(g.LoadGraphFromFile("tests/huge_graph.txt"), std::length_error);
+  EXPECT_THROW(s21::Matrix(SIZE_MAX / 2, SIZE_MAX / 2), std::length_error);
+  EXPECT_THROW(s21::Matrix(1, SIZE_MAX), std::length_error);
+}
+
+TEST(graphClass, parallelTextParser) {
+  std::string const text = "1 -2  3\n4\t5 6\r\n 7 8 9 10";
+  int result[3][3] = {{1, -2, 3}, {4, 5, 6}, {7, 8, 9}};
+  for (unsigned threads = 1; threads <= 8; threads++) {
+    s21::Matrix m(3, 3);
+    s21::parser::ParseMatrix(text.data(), text.data() + text.size(), &m,
+                             threads);
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        EXPECT_EQ(m(i, j), result[i][j]);
+      }
+    }
+  }
+
+  s21::Matrix m(2, 2);
+  std::string const short_text = "1 2 3";
+  EXPECT_THROW(s21::parser::ParseMatrix(short_text.data(),
+                                        short_text.data() + 5, &m),
+               std::runtime_error);
+  std::string const bad_text = "1 2x 3 4";
+  EXPECT_THROW(s21::parser::ParseMatrix(bad_text.data(), bad_text.data() + 8,
+                                        &m, 2),
+               std::runtime_error);
+
+  std::string const symmetric = "1 2 3\n2 5 6\n3 6 9";
+  std::string const asymmetric = "1 2 3\n4 5 6\n3 7 9";
+  int asymmetric_result[3][3] = {{1, 2, 3}, {4, 5, 6}, {3, 7, 9}};
+  for (unsigned threads = 1; threads <= 8; threads++) {
+    s21::BasicTriangularMatrix<int> t(3);
+    s21::Matrix full;
+    EXPECT_TRUE(s21::parser::ParseSymmetricMatrix(
+        symmetric.data(), symmetric.data() + symmetric.size(), &t, &full,
+        threads));
+    EXPECT_EQ(t(2, 1), 6);
+    EXPECT_EQ(t(0, 2), 3);
+    EXPECT_EQ(full.GetRows(), 0u);
+    EXPECT_FALSE(s21::parser::ParseSymmetricMatrix(
+        asymmetric.data(), asymmetric.data() + asymmetric.size(), &t, &full,
+        threads));
+    ASSERT_EQ(full.GetRows(), 3u);
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        EXPECT_EQ(full(i, j), asymmetric_result[i][j]);
+      }
+    }
+  }
+}
+
+TEST(graphClass, loadFromDimacs) {
+  s21::Graph g;
+  g.LoadGraphFromDimacs("tests/test_graph.gr");
+  const s21::Graph& graph = g;
+
+  EXPECT_TRUE(g.IsSparse());
+  EXPECT_EQ(g.AmountOfVertices(), 5);
+  int result[5][5] = {{0, 4, 9, 0, 0},
+                      {0, 0, 3, 0, 0},
+                      {0, 0, 0, 2, 0},
+                      {7, 0, 0, 0, 0},
+                      {0, 0, 0, 0, 0}};
+  for (std::size_t i = 0; i < 5; ++i) {
+    for (std::size_t j = 0; j < 5; ++j) {
+      EXPECT_EQ(graph(i, j), result[i][j]);
+    }
+  }
+  EXPECT_THROW(g.LoadGraphFromDimacs("tests/test_graph_2.txt"),
+               std::runtime_error);
+}
+
+TEST(graphClass, loadFromEdgeList) {
+  s21::Graph directed, undirected;
+  directed.LoadGraphFromEdgeList("tests/test_edge_list.txt");
+  undirected.LoadGraphFromEdgeList("tests/test_edge_list.txt", true);
+  const s21::Graph& d = directed;
+  const s21::Graph& u = undirected;
+
+  EXPECT_EQ(d.AmountOfVertices(), 3);
+  EXPECT_EQ(d(0, 1), 4);
+  EXPECT_EQ(d(1, 0), 0);
+  EXPECT_EQ(d(2, 0), 1);
+  EXPECT_EQ(u(1, 0), 4);
+  EXPECT_EQ(u(0, 2), 1);
+  EXPECT_EQ(u(2, 0), 1);
+  EXPECT_EQ(u(2, 1), 3);
+  EXPECT_THROW(directed.LoadGraphFromEdgeList("tests/test_graph_2.txt"),
+               std::runtime_error);
+}
+
 TEST(graphClass, exportToDot0) {
   s21::Graph g;
   g.LoadGraphFromFile("tests/test_graph_2.txt");
   g.ExportGraphToDot("test_dot.dot");
 
+  EXPECT_TRUE(findSubstringInFile("graph graphname {", "test_dot.dot"));
+  EXPECT_FALSE(findSubstringInFile("digraph", "test_dot.dot"));
   for (std::size_t i = 0; i < g.AmountOfVertices(); ++i) {
     for (std::size_t j = i; j < g.AmountOfVertices(); ++j) {
-      std::string substr =
-          "v" + std::to_string(i + 1) + " -- v" + std::to_string(j + 1) + ";";
+      std::string substr = "v" + std::to_string(i + 1) + " -- v" +
+                           std::to_string(j + 1) + " [weight=" +
+                           std::to_string(g(i, j)) + "];";
       bool res = findSubstringInFile(substr, "test_dot.dot");
       EXPECT_EQ(res, g(i, j) != 0);
     }
@@ -146,16 +392,593 @@ TEST(graphClass, exportToDot1) {
   g.LoadGraphFromFile("tests/test_graph_4.txt");
   g.ExportGraphToDot("test_dot.dot");
 
+  EXPECT_TRUE(findSubstringInFile("digraph graphname {", "test_dot.dot"));
   for (std::size_t i = 0; i < g.AmountOfVertices(); ++i) {
     for (std::size_t j = 0; j < g.AmountOfVertices(); ++j) {
-      std::string substr =
-          "v" + std::to_string(i + 1) + " -> v" + std::to_string(j + 1) + ";";
+      std::string substr = "v" + std::to_string(i + 1) + " -> v" +
+                           std::to_string(j + 1) + " [weight=" +
+                           std::to_string(g(i, j)) + "];";
       bool res = findSubstringInFile(substr, "test_dot.dot");
       EXPECT_EQ(res, g(i, j) != 0);
     }
   }
 }
 
+TEST(graphClass, exportToDotParallel) {
+  // Large enough to be cut into several blocks.
+  s21::BasicGraph<double> g(400);
+  for (std::size_t i = 0; i < 400; ++i) {
+    for (std::size_t j = 0; j < 400; ++j) {
+      if ((i + j) % 3 != 0) g(i, j) = 0.5 * (double)((3 * i + j) % 7 + 1);
+    }
+  }
+  auto const read = [](const std::string& filename) {
+    std::ifstream file(filename);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  };
+  g.ExportGraphToDot("test_dot.dot", 1);
+  std::string const sequential = read("test_dot.dot");
+  g.ExportGraphToDot("test_dot.dot", 4);
+  EXPECT_EQ(read("test_dot.dot"), sequential);
+  EXPECT_NE(sequential.find("\tv2 -> v4 [weight=3.5];\n"),
+            std::string::npos);
+  // 53334 of the cells have (i + j) % 3 == 0, two lines are the braces.
+  EXPECT_EQ(std::count(sequential.begin(), sequential.end(), '\n'),
+            400 * 400 - 53334 + 2);
+
+  // A worker that throws does not terminate the program.
+  std::atomic<unsigned> calls(0);
+  EXPECT_THROW(s21::RunParallel(4,
+                                [&calls](unsigned t) {
+                                  calls++;
+                                  if (t != 0) throw std::runtime_error("");
+                                }),
+               std::runtime_error);
+  EXPECT_EQ(calls, 4u);
+  calls = 0;
+  s21::RunParallel(0, [&calls](unsigned t) { calls += t + 1; });
+  EXPECT_EQ(calls, 1u);
+}
+
+TEST(graphClass, sparseStorage) {
+  s21::Graph g;
+  g.LoadGraphFromFile("tests/test_graph_4.txt");
+  s21::Graph dense = g;
+  g.ToSparse();
+
+  EXPECT_TRUE(g.IsSparse());
+  EXPECT_EQ(g.AmountOfVertices(), 6);
+  const s21::Graph& sparse = g;
+  for (std::size_t i = 0; i < g.AmountOfVertices(); ++i) {
+    for (std::size_t j = 0; j < g.AmountOfVertices(); ++j) {
+      EXPECT_EQ(sparse(i, j), dense(i, j));
+    }
+  }
+  g(0, 1) = 7;
+  EXPECT_EQ(sparse(0, 1), 7);
+  EXPECT_EQ(g(0, 0), 0);
+  EXPECT_THROW(sparse(6, 0), std::out_of_range);
+
+  // The sparse storage holds only arcs: writing zero removes one, writing
+  // an absent one adds it, and the searches see both.
+  s21::GraphAlgoritms ga;
+  std::size_t const arcs = g.Csr()->GetNonZeros();
+  g(0, 1) = 0;
+  EXPECT_EQ(g.Csr()->GetNonZeros(), arcs - 1);
+  EXPECT_EQ(g.Csr()->Find(0, 1), nullptr);
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(g, 1, 2), 6);
+  g(0, 0) = 3;
+  EXPECT_EQ(g.Csr()->GetNonZeros(), arcs);
+  EXPECT_EQ(sparse(0, 0), 3);
+  g(0, 1) = 7;
+
+  g.ToDense();
+  EXPECT_FALSE(g.IsSparse());
+  EXPECT_EQ(g(0, 1), 7);
+  EXPECT_EQ(g(5, 5), 8);
+}
+
+TEST(graphClass, csrConstructor) {
+  s21::Graph g(s21::CsrMatrix(3, 3, {0, 2, 2, 3}, {1, 2, 0}, {4, 5, 6}));
+  std::vector<std::pair<std::size_t, int>> neighbors;
+  g.ForEachNeighbor(0, [&neighbors](std::size_t to, int weight) {
+    neighbors.emplace_back(to, weight);
+  });
+
+  EXPECT_EQ(g.AmountOfVertices(), 3);
+  EXPECT_EQ(neighbors,
+            (std::vector<std::pair<std::size_t, int>>{{1, 4}, {2, 5}}));
+  EXPECT_THROW(s21::CsrMatrix(2, 2, {0, 2, 2}, {1, 0}, {1, 1}),
+               std::invalid_argument);
+  EXPECT_THROW(s21::CsrMatrix(3, 3, {0, 1, 2, 2}, {1, 2}, {0, 5}),
+               std::invalid_argument);
+  // Column ids must fit the 32 bit index type.
+  std::size_t const too_wide = std::size_t(UINT32_MAX) + 1;
+  EXPECT_THROW(s21::CsrMatrix(1, too_wide, {0, 0}, {}, {}),
+               std::length_error);
+  s21::CsrMatrix csr(3, 3, {0, 2, 2, 3}, {1, 2, 0}, {4, 5, 6});
+  EXPECT_THROW(csr.Find(0, too_wide), std::out_of_range);
+  EXPECT_THROW(csr.Insert(0, too_wide, 1), std::out_of_range);
+  EXPECT_THROW(csr.Erase(0, too_wide), std::out_of_range);
+}
+
+TEST(graphClass, mutationLog) {
+  for (bool sparse : {false, true}) {
+    s21::Graph g;
+    g.LoadGraphFromFile("tests/test_graph_2.txt");
+    // One arc at a time: the triangular storage would change both.
+    if (sparse) {
+      g.ToSparse();
+    } else {
+      g.ToDense();
+    }
+    std::uint64_t const loaded = g.Version();
+
+    g.AddEdge(0, 4, 7);
+    g.SetWeight(0, 1, 2);
+    g.RemoveEdge(3, 5);
+    const s21::Graph& graph = g;
+    EXPECT_EQ(graph(0, 4), 7);
+    EXPECT_EQ(graph(0, 1), 2);
+    EXPECT_EQ(graph(3, 5), 0);
+    EXPECT_EQ(g.Version(), loaded + 3);
+    EXPECT_THROW(g.AddEdge(0, 4, 1), std::logic_error);
+    EXPECT_THROW(g.RemoveEdge(3, 5), std::logic_error);
+    EXPECT_THROW(g.SetWeight(0, 2, 0), std::invalid_argument);
+    EXPECT_THROW(g.AddEdge(0, 6, 1), std::out_of_range);
+
+    auto changes = g.ChangesSince(loaded + 1);
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].version, loaded + 2);
+    EXPECT_EQ(changes[0].old_weight, 6);
+    EXPECT_EQ(changes[0].new_weight, 2);
+    EXPECT_EQ(changes[1].from, 3);
+    EXPECT_EQ(changes[1].to, 5);
+    EXPECT_EQ(changes[1].new_weight, 0);
+
+    // Writes through operator() are logged like the mutations, and one
+    // that keeps the weight is not logged at all.
+    g(0, 1) += 3;
+    g(0, 5) = 4;
+    g(0, 5) = 4;
+    EXPECT_EQ(graph(0, 1), 5);
+    EXPECT_EQ(g.Version(), loaded + 5);
+    changes = g.ChangesSince(loaded + 3);
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].old_weight, 2);
+    EXPECT_EQ(changes[0].new_weight, 5);
+    EXPECT_EQ(changes[1].to, 5);
+    EXPECT_EQ(changes[1].old_weight, 0);
+
+    g.TrimChangeLog(loaded + 2);
+    EXPECT_EQ(g.ChangesSince(loaded + 2).size(), 3);
+    EXPECT_THROW(g.ChangesSince(loaded + 1), std::out_of_range);
+    g.LoadGraphFromFile("tests/test_graph_2.txt");
+    EXPECT_GT(g.Version(), loaded + 5);
+    EXPECT_TRUE(g.ChangesSince(g.Version()).empty());
+
+    // Assigning another graph never takes the version back.
+    std::uint64_t const before = g.Version();
+    g = s21::Graph(3);
+    EXPECT_GT(g.Version(), before);
+    EXPECT_THROW(g.ChangesSince(before), std::out_of_range);
+  }
+}
+
+TEST(graphClass, copyOnWrite) {
+  for (bool sparse : {false, true}) {
+    s21::Graph g;
+    g.LoadGraphFromFile("tests/test_graph_2.txt");
+    if (sparse) g.ToSparse();
+    const s21::Graph snapshot = g;
+    g(0, 1) = 9;
+    g.RemoveEdge(0, 2);
+    EXPECT_EQ(snapshot(0, 1), 6);
+    EXPECT_EQ(snapshot(0, 2), 1);
+    EXPECT_EQ(static_cast<const s21::Graph&>(g)(0, 1), 9);
+
+    // Reading through the non-const operator() neither copies the storage
+    // nor drops the derived structures.
+    s21::Graph reader = snapshot;
+    auto const csr = reader.Csr();
+    EXPECT_EQ(reader(0, 1), 6);
+    EXPECT_EQ(reader(1, 1), 0);
+    EXPECT_EQ(reader.Csr(), csr);
+    if (sparse) {
+      EXPECT_EQ(snapshot.Csr(), csr);
+    }
+  }
+}
+
+TEST(graphClass, publisherSnapshots) {
+  s21::Graph g;
+  g.LoadGraphFromFile("tests/test_graph_2.txt");
+  g.ToDense();
+  s21::GraphPublisher publisher(g);
+
+  // The writer keeps (0, 1) and (1, 0) equal in every version it
+  // publishes, readers must never see them apart.
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; t++) {
+    readers.emplace_back([&publisher, &done, &torn] {
+      while (!done) {
+        std::this_thread::yield();
+        auto snapshot = publisher.Snapshot();
+        if ((*snapshot)(0, 1) != (*snapshot)(1, 0)) torn++;
+      }
+    });
+  }
+  for (int weight = 1; weight <= 100; weight++) {
+    publisher.Update([weight](s21::Graph* next) {
+      next->SetWeight(0, 1, weight);
+      next->SetWeight(1, 0, weight);
+    });
+  }
+  done = true;
+  for (std::thread& reader : readers) reader.join();
+
+  EXPECT_EQ(torn, 0);
+  auto last = publisher.Snapshot();
+  EXPECT_EQ((*last)(0, 1), 100);
+  EXPECT_EQ(last->Version(), g.Version() + 200);
+  EXPECT_EQ(last->ChangesSince(last->Version() - 2).size(), 2);
+  EXPECT_THROW(last->ChangesSince(last->Version() - 3), std::out_of_range);
+  EXPECT_EQ(g(0, 1), 6);
+}
+
+TEST(graphClass, triangularStorage) {
+  s21::Graph g;
+  g.LoadGraphFromFile("tests/test_graph_2.txt");
+  EXPECT_TRUE(g.IsTriangular());
+  s21::Graph dense = g;
+  dense.ToDense();
+  s21::GraphAlgoritms ga;
+  EXPECT_EQ(ga.breadthFirstSearch(g, 2), ga.breadthFirstSearch(dense, 2));
+  EXPECT_EQ(ga.getShortestPathsBetweenAllVertices(g),
+            ga.getShortestPathsBetweenAllVertices(dense));
+  EXPECT_EQ(ga.getLeastSpanningTree(g), ga.getLeastSpanningTree(dense));
+
+  g.ExportGraphToBinary("test_dense.bin");
+  s21::Graph loaded;
+  loaded.LoadGraphFromBinary("test_dense.bin");
+  EXPECT_TRUE(loaded.IsTriangular());
+  const s21::Graph& expected = dense;
+  for (std::size_t i = 0; i < 6; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) {
+      EXPECT_EQ(loaded(i, j), expected(i, j));
+    }
+  }
+  // Reads do not expand the packed storage, nor do writes that keep it
+  // symmetric; setting one arc apart from the other does.
+  EXPECT_TRUE(loaded.IsTriangular());
+  loaded(0, 1) = 6;
+  loaded(2, 2) = 3;
+  EXPECT_TRUE(loaded.IsTriangular());
+  loaded(0, 1) = 9;
+  EXPECT_FALSE(loaded.IsTriangular());
+  EXPECT_EQ(static_cast<const s21::Graph&>(loaded)(1, 0), 6);
+  EXPECT_EQ(static_cast<const s21::Graph&>(loaded)(2, 2), 3);
+
+  // The tracked mutations change both arcs in place and log both.
+  const s21::Graph snapshot = g;
+  std::uint64_t const version = g.Version();
+  g.SetWeight(0, 1, 9);
+  g.AddEdge(4, 0, 7);
+  g.RemoveEdge(3, 5);
+  g.AddEdge(1, 1, 2);
+  EXPECT_TRUE(g.IsTriangular());
+  EXPECT_FALSE(g.IsDirected());
+  const s21::Graph& graph = g;
+  EXPECT_EQ(graph(1, 0), 9);
+  EXPECT_EQ(graph(0, 4), 7);
+  EXPECT_EQ(graph(5, 3), 0);
+  EXPECT_EQ(graph(1, 1), 2);
+  EXPECT_EQ(snapshot(0, 1), 6);
+  EXPECT_THROW(g.AddEdge(0, 4, 1), std::logic_error);
+  auto const changes = g.ChangesSince(version);
+  ASSERT_EQ(changes.size(), 7u);
+  EXPECT_EQ(g.Version(), version + 7);
+  EXPECT_EQ(changes[2].from, 4u);
+  EXPECT_EQ(changes[3].from, 0u);
+  EXPECT_EQ(changes[3].to, 4u);
+  EXPECT_EQ(changes[5].old_weight, 2);
+  EXPECT_EQ(changes[6].to, 1u);
+
+  s21::GraphPublisher publisher(g);
+  publisher.Update([](s21::Graph* next) { next->SetWeight(2, 5, 1); });
+  EXPECT_TRUE(publisher.Snapshot()->IsTriangular());
+  EXPECT_EQ((*publisher.Snapshot())(5, 2), 1);
+
+  g(0, 1) = 8;
+  EXPECT_FALSE(g.IsTriangular());
+  EXPECT_EQ(graph(1, 0), 9);
+  EXPECT_THROW(g.ToTriangular(), std::logic_error);
+
+  s21::Graph directed;
+  directed.LoadGraphFromFile("tests/test_graph_4.txt");
+  EXPECT_FALSE(directed.IsTriangular());
+}
+
+TEST(graphClass, loadSymmetricFile) {
+  // A symmetric file is parsed into the packed triangle without ever
+  // allocating the V x V matrix; the first asymmetric cell makes it fall
+  // back to the dense storage.
+  std::size_t const n = 200;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> weight(0, 9);
+  s21::Matrix m(n, n);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = i; j < n; ++j) m(i, j) = m(j, i) = weight(gen);
+  }
+  auto const write = [&m, n] {
+    std::ofstream file("test_symmetric.txt");
+    file << n << '\n';
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < n; ++j) file << m(i, j) << ' ';
+      file << '\n';
+    }
+  };
+  write();
+
+  s21::Graph g;
+  largest_allocation = 0;
+  g.LoadGraphFromFile("test_symmetric.txt");
+#ifdef S21_COUNT_ALLOCATIONS
+  EXPECT_LT(largest_allocation, n * n * sizeof(int));
+#endif
+  EXPECT_TRUE(g.IsTriangular());
+  EXPECT_FALSE(g.IsDirected());
+
+  m(n - 1, n - 2) = 10;
+  write();
+  g.LoadGraphFromFile("test_symmetric.txt");
+  EXPECT_FALSE(g.IsTriangular());
+  EXPECT_TRUE(g.IsDirected());
+  const s21::Graph& graph = g;
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) EXPECT_EQ(graph(i, j), m(i, j));
+  }
+}
+
+TEST(graphClass, vertexReordering) {
+  s21::Graph original;
+  original.LoadGraphFromFile("tests/test_graph_4.txt");
+  s21::GraphAlgoritms ga;
+  for (s21::VertexOrder order : {s21::VertexOrder::kReverseCuthillMcKee,
+                                 s21::VertexOrder::kBreadthFirst,
+                                 s21::VertexOrder::kDegree}) {
+    for (bool sparse : {false, true}) {
+      s21::Graph g = original;
+      if (sparse) g.ToSparse();
+      g.Reorder(order);
+      const s21::Graph& graph = g;
+      for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(g.ToStorageId(g.ToOriginalId(i)), i);
+        for (std::size_t j = 0; j < 6; ++j) {
+          EXPECT_EQ(graph(i, j), original(i, j));
+        }
+      }
+      EXPECT_EQ(ga.getShortestPathBetweenVertices(g, 2, 5),
+                ga.getShortestPathBetweenVertices(original, 2, 5));
+      EXPECT_EQ(ga.getShortestPathsBetweenAllVertices(g),
+                ga.getShortestPathsBetweenAllVertices(original));
+      // The visit order does not depend on the storage order.
+      for (int start = 1; start <= 6; ++start) {
+        EXPECT_EQ(ga.breadthFirstSearch(g, start),
+                  ga.breadthFirstSearch(original, start));
+        EXPECT_EQ(ga.depthFirstSearch(g, start),
+                  ga.depthFirstSearch(original, start));
+      }
+
+      g.ExportGraphToBinary("test_sparse.bin");
+      s21::Graph loaded;
+      loaded.LoadGraphFromBinary("test_sparse.bin");
+      EXPECT_TRUE(loaded.IsReordered());
+      EXPECT_EQ(static_cast<const s21::Graph&>(loaded)(5, 5), 8);
+      EXPECT_EQ(loaded.ToOriginalId(0), g.ToOriginalId(0));
+
+      g.Reorder(s21::VertexOrder::kOriginal);
+      EXPECT_FALSE(g.IsReordered());
+      EXPECT_EQ(graph(0, 1), 6);
+    }
+  }
+
+  s21::Graph undirected;
+  undirected.LoadGraphFromFile("tests/test_graph_2.txt");
+  s21::Graph reordered = undirected;
+  reordered.Reorder(s21::VertexOrder::kReverseCuthillMcKee);
+  EXPECT_TRUE(reordered.IsTriangular());
+  auto const total = [](const s21::Matrix& tree) {
+    int sum = 0;
+    for (std::size_t i = 0; i < 6; ++i) {
+      for (std::size_t j = 0; j < 6; ++j) sum += tree(i, j);
+    }
+    return sum;
+  };
+  EXPECT_EQ(total(ga.getLeastSpanningTree(reordered)),
+            total(ga.getLeastSpanningTree(undirected)));
+}
+
+TEST(graphClass, derivedCache) {
+  s21::Graph g;
+  g.LoadGraphFromFile("tests/test_graph_4.txt");
+  EXPECT_TRUE(g.IsDirected());
+  EXPECT_EQ(g.MaxWeight(), 8);
+  EXPECT_FALSE(g.HasUniformWeights());
+
+  auto const csr = g.Csr();
+  EXPECT_EQ(csr, g.Csr());
+  EXPECT_EQ(csr->GetNonZeros(), 23u);
+  auto const reverse = g.ReverseCsr();
+  ASSERT_EQ(reverse->RowEnd(0) - reverse->RowBegin(0), 3u);
+  EXPECT_EQ(reverse->Columns()[reverse->RowBegin(0)], 1u);
+  EXPECT_EQ(*reverse->Find(0, 2), 1);
+  auto const degrees = g.OutDegrees();
+  EXPECT_EQ(*degrees, std::vector<std::size_t>({4, 4, 5, 3, 3, 4}));
+  auto const sorted = g.NeighborsByWeight();
+  EXPECT_EQ(std::vector<std::size_t>(sorted->targets.begin(),
+                                     sorted->targets.begin() + 4),
+            std::vector<std::size_t>({2, 5, 3, 1}));
+
+  // A copy shares the cache; a write drops only the writer's one.
+  s21::Graph copy = g;
+  EXPECT_EQ(copy.Csr(), csr);
+  copy.AddEdge(0, 4, 9);
+  EXPECT_EQ((*copy.OutDegrees())[0], 5u);
+  EXPECT_EQ(copy.MaxWeight(), 9);
+  EXPECT_EQ((*g.OutDegrees())[0], 4u);
+  EXPECT_EQ(g.Csr(), csr);
+  EXPECT_EQ(degrees->at(0), 4u);
+
+  s21::Graph uniform(3);
+  uniform(0, 1) = 2;
+  uniform(1, 2) = 2;
+  EXPECT_TRUE(uniform.HasUniformWeights());
+  s21::GraphAlgoritms ga;
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(uniform, 1, 3), 4);
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(uniform, 3, 1), -1);
+}
+
+TEST(graphClass, binaryRoundTrip) {
+  s21::Graph text;
+  text.LoadGraphFromFile("tests/test_graph_4.txt");
+  s21::Graph sparse = text;
+  sparse.ToSparse();
+  text.ExportGraphToBinary("test_dense.bin");
+  sparse.ExportGraphToBinary("test_sparse.bin");
+
+  s21::Graph dense_binary, sparse_binary;
+  dense_binary.LoadGraphFromBinary("test_dense.bin");
+  sparse_binary.LoadGraphFromBinary("test_sparse.bin");
+
+  EXPECT_FALSE(dense_binary.IsSparse());
+  EXPECT_TRUE(sparse_binary.IsSparse());
+  ASSERT_EQ(dense_binary.AmountOfVertices(), 6);
+  ASSERT_EQ(sparse_binary.AmountOfVertices(), 6);
+  const s21::Graph& expected = text;
+  for (std::size_t i = 0; i < 6; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) {
+      EXPECT_EQ(dense_binary(i, j), expected(i, j));
+      EXPECT_EQ(static_cast<const s21::Graph&>(sparse_binary)(i, j),
+                expected(i, j));
+    }
+  }
+
+  dense_binary(0, 0) = 42;
+  s21::Graph reloaded;
+  reloaded.LoadGraphFromBinary("test_dense.bin");
+  EXPECT_EQ(reloaded(0, 0), 0);
+
+  // The stored direction is trusted, unless the load is verified.
+  EXPECT_TRUE(sparse_binary.IsDirected());
+  std::string bytes;
+  {
+    std::ifstream file("test_sparse.bin", std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  bytes[offsetof(s21::binary::Header, directed)] = 0;
+  std::ofstream("test_sparse.bin", std::ios::binary) << bytes;
+  reloaded.LoadGraphFromBinary("test_sparse.bin");
+  EXPECT_FALSE(reloaded.IsDirected());
+  EXPECT_THROW(reloaded.LoadGraphFromBinary("test_sparse.bin", true),
+               std::runtime_error);
+}
+
+TEST(graphClass, binaryInvalidColumns) {
+  s21::Graph g;
+  g.LoadGraphFromFile("tests/test_graph_4.txt");
+  g.ToSparse();
+  g.ExportGraphToBinary("test_sparse.bin");
+  std::string bytes;
+  {
+    std::ifstream file("test_sparse.bin", std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  // Row 0 holds the arcs to 1, 2, 3 and 5.
+  std::size_t const columns = s21::binary::AlignSection(
+      s21::binary::AlignSection(sizeof(s21::binary::Header)) +
+      7 * sizeof(std::uint64_t));
+  auto const write_column = [&bytes, columns](std::size_t k,
+                                              std::uint32_t column) {
+    std::memcpy(&bytes[columns + k * sizeof(column)], &column,
+                sizeof(column));
+    std::ofstream("test_sparse.bin", std::ios::binary) << bytes;
+  };
+
+  s21::Graph loaded;
+  write_column(0, 6);
+  EXPECT_THROW(loaded.LoadGraphFromBinary("test_sparse.bin"),
+               std::runtime_error);
+  write_column(0, 3);
+  EXPECT_THROW(loaded.LoadGraphFromBinary("test_sparse.bin"),
+               std::runtime_error);
+  write_column(0, 1);
+  loaded.LoadGraphFromBinary("test_sparse.bin");
+  EXPECT_EQ(static_cast<const s21::Graph&>(loaded)(0, 5), 2);
+
+  // A stored zero would be an arc the graph reports as missing.
+  s21::binary::Header header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  std::size_t const values = s21::binary::AlignSection(
+      columns + header.non_zeros * sizeof(std::uint32_t));
+  int const zero = 0;
+  std::memcpy(&bytes[values], &zero, sizeof(zero));
+  std::ofstream("test_sparse.bin", std::ios::binary) << bytes;
+  EXPECT_THROW(loaded.LoadGraphFromBinary("test_sparse.bin"),
+               std::runtime_error);
+}
+
+TEST(graphClass, binaryInvalidFile) {
+  s21::Graph g;
+  EXPECT_THROW(g.LoadGraphFromBinary("tests/test_graph_2.txt"),
+               std::runtime_error);
+  EXPECT_THROW(g.LoadGraphFromBinary("tests/no_such_file.bin"),
+               std::runtime_error);
+}
+
+TEST(graphClass, weightTypes) {
+  s21::Graph g;
+  g.LoadGraphFromFile("tests/test_graph_2.txt");
+  s21::BasicGraph<std::int16_t> narrow;
+  narrow.LoadGraphFromFile("tests/test_graph_2.txt");
+  s21::BasicGraph<float> real;
+  real.LoadGraphFromFile("tests/test_graph_2.txt");
+  s21::GraphAlgoritms ga;
+
+  s21::BasicMatrix<std::int16_t> narrow_paths =
+      ga.getShortestPathsBetweenAllVertices(narrow);
+  s21::BasicMatrix<float> real_paths =
+      ga.getShortestPathsBetweenAllVertices(real);
+  s21::Matrix int_paths = ga.getShortestPathsBetweenAllVertices(g);
+  for (std::size_t i = 0; i < 6; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) {
+      EXPECT_EQ(narrow_paths(i, j), int_paths(i, j));
+      EXPECT_FLOAT_EQ(real_paths(i, j), (float)int_paths(i, j));
+    }
+  }
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(narrow, 2, 4), 10);
+  EXPECT_FLOAT_EQ(ga.getShortestPathBetweenVertices(real, 2, 4), 10.f);
+  EXPECT_EQ(ga.breadthFirstSearch(real, 1), ga.breadthFirstSearch(narrow, 1));
+}
+
+TEST(graphClass, weightTypedBinary) {
+  s21::BasicGraph<double> g;
+  g.LoadGraphFromFile("tests/test_graph_4.txt");
+  g(0, 1) = 0.5;
+  g.ExportGraphToBinary("test_dense.bin");
+
+  s21::BasicGraph<double> loaded;
+  loaded.LoadGraphFromBinary("test_dense.bin");
+  EXPECT_DOUBLE_EQ(loaded(0, 1), 0.5);
+  EXPECT_DOUBLE_EQ(loaded(5, 5), 8.0);
+
+  s21::Graph other_type;
+  EXPECT_THROW(other_type.LoadGraphFromBinary("test_dense.bin"),
+               std::runtime_error);
+}
+
 TEST(searchAlgs, breadthFirst) {
   s21::Graph g;
   g.LoadGraphFromFile("tests/test_graph_2.txt");
@@ -227,6 +1050,646 @@ TEST(getLeastSpanningTree, test_1) {
   }
 }
 
+TEST(getLeastSpanningTree, tiesAndDisconnected) {
+  // Every edge weighs 1, so the tree is decided by the tie-breaking, which
+  // must not depend on the storage order.
+  s21::Graph g(6);
+  for (auto [i, j] : {std::pair{0, 5}, {5, 1}, {1, 4}, {4, 2}, {2, 3},
+                      {3, 0}, {0, 4}, {1, 3}}) {
+    g(i, j) = 1;
+    g(j, i) = 1;
+  }
+  s21::GraphAlgoritms ga;
+  s21::Graph reordered = g;
+  reordered.Reorder(s21::VertexOrder::kReverseCuthillMcKee);
+  ASSERT_NE(reordered.ToStorageId(0), 0);
+  auto const tree = ga.getLeastSpanningTree(g);
+  EXPECT_EQ(ga.getLeastSpanningTree(reordered), tree);
+  EXPECT_EQ(tree(0, 3), 1);
+  EXPECT_EQ(tree(0, 4), 1);
+  EXPECT_EQ(tree(0, 0), 0);
+  EXPECT_EQ(ga.NearestNeighborSolveTravelingSalesmanProblem(reordered).vertices,
+            ga.NearestNeighborSolveTravelingSalesmanProblem(g).vertices);
+
+  // Vertex 6 can not be reached: the tree of the others is marked.
+  g.RemoveEdge(0, 5);
+  g.RemoveEdge(5, 0);
+  g.RemoveEdge(5, 1);
+  g.RemoveEdge(1, 5);
+  auto const partial = ga.getLeastSpanningTree(g);
+  EXPECT_EQ(partial(0, 0), -1);
+  EXPECT_EQ(partial(0, 3), 1);
+}
+
+TEST(searchAlgs, sparseGraph) {
+  s21::Graph dense;
+  dense.LoadGraphFromFile("tests/test_graph_2.txt");
+  s21::Graph sparse = dense;
+  sparse.ToSparse();
+  s21::GraphAlgoritms ga;
+
+  EXPECT_EQ(ga.breadthFirstSearch(sparse, 1), ga.breadthFirstSearch(dense, 1));
+  EXPECT_EQ(ga.depthFirstSearch(sparse, 1), ga.depthFirstSearch(dense, 1));
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(sparse, 2, 4), 10);
+  EXPECT_EQ(ga.getShortestPathsBetweenAllVertices(sparse),
+            ga.getShortestPathsBetweenAllVertices(dense));
+  EXPECT_EQ(ga.getLeastSpanningTree(sparse), ga.getLeastSpanningTree(dense));
+}
+
+TEST(searchAlgs, bitMatrixGraph) {
+  // 150 vertices span three words per row.
+  s21::Graph g(150);
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<std::size_t> vertex(0, 149);
+  for (int k = 0; k < 600; k++) g(vertex(gen), vertex(gen)) = 1;
+  s21::BitMatrix bits = g.ToBitMatrix();
+  EXPECT_EQ(bits.GetWordsPerRow(), 3);
+  EXPECT_TRUE(bits.Test(0, 0) == (g(0, 0) != 0));
+  s21::GraphAlgoritms ga;
+
+  for (int start : {1, 64, 65, 150}) {
+    EXPECT_EQ(ga.breadthFirstSearch(bits, start),
+              ga.breadthFirstSearch(g, start));
+    EXPECT_EQ(ga.depthFirstSearch(bits, start), ga.depthFirstSearch(g, start));
+  }
+  EXPECT_THROW(ga.breadthFirstSearch(bits, 151), std::out_of_range);
+  s21::BitMatrix wide(2, 3);
+  wide.Set(0, 2);
+  EXPECT_THROW(ga.breadthFirstSearch(wide, 1), std::invalid_argument);
+  EXPECT_THROW(ga.depthFirstSearch(wide, 1), std::invalid_argument);
+}
+
+TEST(searchAlgs, directionOptimizingBfs) {
+  // A low-diameter graph: the frontier quickly gets large enough for the
+  // bottom-up steps.
+  s21::Graph g(300);
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<std::size_t> vertex(0, 299);
+  for (int k = 0; k < 3000; k++) g(vertex(gen), vertex(gen)) = 2;
+  g.ToSparse();
+  g.Reorder(s21::VertexOrder::kDegree);
+  const s21::Graph& graph = g;
+  s21::GraphAlgoritms ga;
+  using Mode = s21::GraphAlgoritms::BfsMode;
+
+  for (int start : {1, 150, 300}) {
+    auto const top_down = ga.breadthFirstSearchTree(g, start, Mode::kTopDown);
+    std::vector<int> expected = ga.breadthFirstSearch(g, start);
+    std::sort(expected.begin(), expected.end());
+    for (Mode mode : {Mode::kBottomUp, Mode::kDirectionOptimizing}) {
+      auto const tree = ga.breadthFirstSearchTree(g, start, mode);
+      EXPECT_EQ(tree.level, top_down.level);
+      std::vector<int> visited = tree.visited;
+      EXPECT_EQ(visited.front(), start);
+      std::sort(visited.begin(), visited.end());
+      EXPECT_EQ(visited, expected);
+      EXPECT_EQ(tree.parent[start - 1], start);
+      for (int v : tree.visited) {
+        if (v == start) continue;
+        int const p = tree.parent[v - 1];
+        EXPECT_NE(graph(p - 1, v - 1), 0);
+        EXPECT_EQ(tree.level[p - 1] + 1, tree.level[v - 1]);
+      }
+    }
+  }
+  EXPECT_THROW(ga.breadthFirstSearchTree(g, 0), std::out_of_range);
+}
+
+TEST(searchAlgs, parallelBfs) {
+  // Frontiers of a few thousand vertices, split among the workers.
+  s21::Graph g = RandomSparseGraph(5000, 8, 5);
+  s21::GraphAlgoritms ga;
+  s21::ThreadPool pool(4);
+
+  for (int start : {1, 2500}) {
+    auto const expected = ga.breadthFirstSearchTree(
+        g, start, s21::GraphAlgoritms::BfsMode::kTopDown);
+    for (int run = 0; run < 3; run++) {
+      auto const tree = ga.parallelBreadthFirstSearch(g, start, &pool);
+      EXPECT_EQ(tree.level, expected.level);
+      EXPECT_EQ(tree.visited.size(), expected.visited.size());
+      for (int v : tree.visited) {
+        if (v == start) continue;
+        int const p = tree.parent[v - 1];
+        EXPECT_NE(g.Csr()->Find(p - 1, v - 1), nullptr);
+        EXPECT_EQ(tree.level[p - 1] + 1, tree.level[v - 1]);
+      }
+    }
+    EXPECT_EQ(ga.parallelBreadthFirstSearch(g, start, 1u).level,
+              expected.level);
+  }
+
+  EXPECT_THROW(pool.Run([](unsigned t) {
+    if (t == 2) throw std::runtime_error("worker failed");
+  }),
+               std::runtime_error);
+  std::atomic<unsigned> calls(0);
+  pool.Run([&calls](unsigned) { calls++; });
+  EXPECT_EQ(calls, 4u);
+}
+
+TEST(searchAlgs, reusableWorkspace) {
+  std::size_t const n = 300;
+  s21::Graph g = RandomSparseGraph(n, 5, 17);
+  s21::Graph weighted(n);
+  std::mt19937 gen(23);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 9);
+  for (int k = 0; k < 1500; k++) {
+    weighted(vertex(gen), vertex(gen)) = weight(gen);
+  }
+  weighted.ToSparse();
+  s21::GraphAlgoritms ga;
+  s21::Matrix const all = ga.getShortestPathsBetweenAllVertices(weighted);
+
+  s21::SearchWorkspace workspace;
+  std::vector<int> dfs, bfs;
+  std::vector<int> paths;
+  auto const queries = [&] {
+    paths.clear();
+    for (int start = 1; start <= (int)n; start += 37) {
+      ga.depthFirstSearch(g, start, &workspace, &dfs);
+      ga.breadthFirstSearch(g, start, &workspace, &bfs);
+      for (int end = 1; end <= (int)n; end += 11) {
+        paths.push_back(ga.getShortestPathBetweenVertices(weighted, start,
+                                                          end, &workspace));
+        paths.push_back(
+            ga.getShortestPathBetweenVertices(g, start, end, &workspace));
+      }
+    }
+  };
+  queries();
+  std::size_t const before = allocations;
+  queries();
+#ifdef S21_COUNT_ALLOCATIONS
+  EXPECT_GT(before, 0u);
+  EXPECT_EQ(allocations, before);
+#else
+  (void)before;
+#endif
+
+  std::size_t k = 0;
+  for (int start = 1; start <= (int)n; start += 37) {
+    for (int end = 1; end <= (int)n; end += 11) {
+      int const expected = start == end ? 0 : all(start - 1, end - 1);
+      EXPECT_EQ(paths[k++], expected);
+      EXPECT_EQ(paths[k++],
+                ga.breadthFirstSearchTree(g, start).level[end - 1]);
+    }
+  }
+  EXPECT_EQ(dfs, ga.depthFirstSearch(g, 297));
+  EXPECT_EQ(bfs, ga.breadthFirstSearch(g, 297));
+  EXPECT_THROW(ga.depthFirstSearch(g, 0, &workspace, &dfs), std::out_of_range);
+}
+
+// Counts the hook calls and stops after limit examined vertices.
+struct CountingVisitor : s21::SearchVisitor {
+  std::size_t limit = SIZE_MAX;
+  std::size_t discovered = 0, examined = 0, edges = 0, finished = 0;
+
+  bool DiscoverVertex(int) {
+    discovered++;
+    return true;
+  }
+  bool ExamineVertex(int) { return ++examined < limit; }
+  bool ExamineEdge(int, int, int) {
+    edges++;
+    return true;
+  }
+  bool FinishVertex(int) {
+    finished++;
+    return true;
+  }
+};
+
+TEST(searchAlgs, visitorSearch) {
+  std::size_t const n = 500;
+  s21::Graph g = RandomSparseGraph(n, 3, 5);
+  s21::GraphAlgoritms ga;
+  auto const reached = ga.breadthFirstSearch(g, 1);
+  auto const degrees = g.OutDegrees();
+  std::size_t arcs = 0;
+  for (int v : reached) arcs += (*degrees)[(std::size_t)v - 1];
+
+  CountingVisitor all;
+  EXPECT_TRUE(ga.depthFirstVisit(g, 1, all));
+  EXPECT_EQ(all.discovered, reached.size());
+  EXPECT_EQ(all.examined, reached.size());
+  EXPECT_EQ(all.finished, reached.size());
+  EXPECT_EQ(all.edges, arcs);
+
+  CountingVisitor few;
+  few.limit = 10;
+  EXPECT_FALSE(ga.breadthFirstVisit(g, 1, few));
+  EXPECT_EQ(few.examined, 10u);
+  EXPECT_EQ(few.finished, 9u);
+
+  auto const tree = ga.breadthFirstSearchTree(g, 7);
+  for (int v = 1; v <= (int)n; v += 3) {
+    EXPECT_EQ(ga.isReachable(g, 7, v), tree.level[(std::size_t)v - 1] >= 0);
+  }
+  EXPECT_TRUE(ga.isReachable(g, 7, 7));
+  EXPECT_THROW(ga.isReachable(g, 7, 0), std::out_of_range);
+}
+
+TEST(searchAlgs, bidirectionalBfs) {
+  std::size_t const n = 3000;
+  s21::Graph const g = RandomSparseGraph(n, 3, 41);
+  s21::GraphAlgoritms ga;
+  s21::SearchWorkspace workspace;
+  for (int source = 1; source <= (int)n; source += 397) {
+    auto const tree = ga.breadthFirstSearchTree(g, source);
+    for (int target = 1; target <= (int)n; target += 61) {
+      auto const path =
+          ga.bidirectionalBreadthFirstSearch(g, source, target, &workspace);
+      ASSERT_EQ(path.hops, tree.level[(std::size_t)target - 1]);
+      if (path.hops < 0) {
+        EXPECT_TRUE(path.vertices.empty());
+        continue;
+      }
+      ASSERT_EQ(path.vertices.size(), (std::size_t)path.hops + 1);
+      EXPECT_EQ(path.vertices.front(), source);
+      EXPECT_EQ(path.vertices.back(), target);
+      for (std::size_t k = 1; k < path.vertices.size(); k++) {
+        EXPECT_NE(g(path.vertices[k - 1] - 1, path.vertices[k] - 1), 0);
+      }
+    }
+  }
+
+  // A vertex without in-arcs is unreachable from the others.
+  s21::Graph chain(4);
+  chain(1, 2) = chain(2, 3) = 2;
+  chain(2, 1) = 2;
+  EXPECT_EQ(ga.bidirectionalBreadthFirstSearch(chain, 2, 4).vertices,
+            (std::vector<int>{2, 3, 4}));
+  EXPECT_EQ(ga.bidirectionalBreadthFirstSearch(chain, 3, 1).hops, -1);
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(chain, 3, 2), 2);
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(chain, 2, 1), -1);
+}
+
+TEST(searchAlgs, connectedComponents) {
+  std::size_t const n = 2000;
+  s21::Graph const g = RandomSparseGraph(n, 1, 13);
+  s21::GraphAlgoritms ga;
+  auto const weak = ga.weaklyConnectedComponents(g);
+  auto const strong = ga.stronglyConnectedComponents(g);
+  EXPECT_GT(weak.count, 1);
+  EXPECT_GT(strong.count, weak.count);
+  auto const parallel = ga.parallelWeaklyConnectedComponents(g, 4);
+  EXPECT_EQ(parallel.count, weak.count);
+  EXPECT_EQ(parallel.component, weak.component);
+
+  // The strong components of the graph with every arc doubled backwards
+  // are its weak components.
+  auto const csr = g.Csr();
+  std::vector<std::set<s21::CsrMatrix::index_type>> rows(n);
+  for (std::size_t u = 0; u < n; u++) {
+    csr->ForEachInRow(u, [&](std::size_t v, int) {
+      rows[u].insert((s21::CsrMatrix::index_type)v);
+      rows[v].insert((s21::CsrMatrix::index_type)u);
+    });
+  }
+  std::vector<std::size_t> offsets(1, 0);
+  std::vector<s21::CsrMatrix::index_type> columns;
+  for (auto const& row : rows) {
+    columns.insert(columns.end(), row.begin(), row.end());
+    offsets.push_back(columns.size());
+  }
+  s21::Graph const undirected(s21::CsrMatrix(
+      n, n, offsets, columns, std::vector<int>(columns.size(), 1)));
+  auto const both = ga.stronglyConnectedComponents(undirected);
+  EXPECT_EQ(both.count, weak.count);
+  EXPECT_EQ(both.component, weak.component);
+
+  for (int u = 1; u <= (int)n; u += 97) {
+    for (int v = 1; v <= (int)n; v += 89) {
+      bool const mutual = ga.isReachable(g, u, v) && ga.isReachable(g, v, u);
+      EXPECT_EQ(strong.component[(std::size_t)u - 1] ==
+                    strong.component[(std::size_t)v - 1],
+                mutual);
+    }
+  }
+}
+
+TEST(searchAlgs, int16Distances) {
+  // A chain of std::int16_t arcs, 1 -> 2 -> ... -> 6, whose length is
+  // far above INT16_MAX: the searches sum in 64 bits.
+  s21::BasicGraph<std::int16_t> chain(6);
+  for (std::size_t v = 0; v + 1 < 6; ++v) {
+    chain(v, v + 1) = static_cast<std::int16_t>(30000 + v);
+  }
+  std::int64_t const length = 5 * 30000 + 0 + 1 + 2 + 3 + 4;
+  s21::GraphAlgoritms ga;
+  EXPECT_EQ(ga.getShortestPath(chain, 1, 6).distance, length);
+  EXPECT_EQ(ga.bidirectionalShortestPath(chain, 1, 6).distance, length);
+  auto const landmarks = ga.selectLandmarks(chain, 2);
+  EXPECT_EQ(ga.altShortestPath(chain, landmarks, 1, 6).distance, length);
+  EXPECT_EQ(ga.getShortestPathsFromVertex(chain, 1)[5], length);
+  EXPECT_EQ(ga.deltaSteppingShortestPaths(chain, 1, 2u)[5], length);
+  // The functions returning the weight type can not hold it.
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(chain, 1, 2), 30000);
+  EXPECT_THROW(ga.getShortestPathBetweenVertices(chain, 1, 6),
+               std::overflow_error);
+  EXPECT_THROW(ga.getShortestPathsBetweenAllVertices(chain),
+               std::overflow_error);
+
+  for (std::size_t v = 0; v + 1 < 6; ++v) chain(v, v + 1) = 30000;
+  EXPECT_TRUE(chain.HasUniformWeights());
+  EXPECT_EQ(ga.getShortestPath(chain, 1, 6).distance, 5 * 30000);
+}
+
+TEST(searchAlgs, dijkstraPath) {
+  s21::IndexedHeap<int> heap;
+  heap.Reset(6);
+  for (std::size_t v = 0; v < 6; v++) heap.Push(v, 10 * (int)v + 5);
+  heap.DecreaseKey(4, 1);
+  heap.DecreaseKey(2, 1);
+  std::vector<std::size_t> popped;
+  for (; !heap.Empty(); heap.Pop()) popped.push_back(heap.Top().second);
+  EXPECT_EQ(popped, (std::vector<std::size_t>{2, 4, 0, 1, 3, 5}));
+
+  std::size_t const n = 200;
+  s21::Graph g(n);
+  std::mt19937 gen(31);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 20);
+  for (int k = 0; k < 900; k++) g(vertex(gen), vertex(gen)) = weight(gen);
+  g.ToSparse();
+  s21::Graph const& graph = g;
+  s21::GraphAlgoritms ga;
+  s21::Matrix const all = ga.getShortestPathsBetweenAllVertices(graph);
+  s21::SearchWorkspace workspace;
+  for (int u = 1; u <= (int)n; u += 13) {
+    for (int v = 1; v <= (int)n; v += 7) {
+      auto const path = ga.getShortestPath(graph, u, v, &workspace);
+      int const expected = u == v ? 0 : all(u - 1, v - 1);
+      ASSERT_EQ(path.distance, expected);
+      if (expected < 0) {
+        EXPECT_TRUE(path.vertices.empty());
+        continue;
+      }
+      ASSERT_FALSE(path.vertices.empty());
+      EXPECT_EQ(path.vertices.front(), u);
+      EXPECT_EQ(path.vertices.back(), v);
+      int length = 0;
+      for (std::size_t k = 1; k < path.vertices.size(); k++) {
+        length += graph(path.vertices[k - 1] - 1, path.vertices[k] - 1);
+      }
+      EXPECT_EQ(length, expected);
+    }
+  }
+}
+
+TEST(searchAlgs, bucketQueues) {
+  std::size_t const n = 400;
+  s21::Graph g(n);
+  std::mt19937 gen(37);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(0, 300);
+  for (int k = 0; k < 2400; k++) g(vertex(gen), vertex(gen)) = weight(gen);
+  g.ToSparse();
+  s21::GraphAlgoritms ga;
+  using Queue = s21::GraphAlgoritms::PriorityQueue;
+  s21::SearchWorkspace workspace;
+  for (int u = 1; u <= (int)n; u += 29) {
+    for (int v = 1; v <= (int)n; v += 17) {
+      int const expected = ga.getShortestPathBetweenVertices(g, u, v);
+      EXPECT_EQ(ga.getShortestPathBetweenVertices(g, u, v, Queue::kDial,
+                                                  &workspace),
+                expected);
+      EXPECT_EQ(ga.getShortestPathBetweenVertices(g, u, v, Queue::kRadixHeap,
+                                                  &workspace),
+                expected);
+    }
+  }
+
+  // Weights above the ring cap of Dial's queue go to the radix heap.
+  s21::Graph heavy(4);
+  heavy(0, 1) = 2000000000;
+  heavy(1, 2) = 3;
+  heavy(0, 2) = 1999999999;
+  heavy(2, 3) = 1;
+  EXPECT_EQ(ga.getShortestPathBetweenVertices(heavy, 1, 4, Queue::kDial,
+                                              &workspace),
+            2000000000);
+
+  s21::BasicGraph<double> real(3);
+  real(0, 1) = 0.5;
+  EXPECT_THROW(ga.getShortestPathBetweenVertices(real, 1, 2, Queue::kDial),
+               std::invalid_argument);
+  s21::Graph negative(3);
+  negative(0, 1) = -2;
+  EXPECT_THROW(
+      ga.getShortestPathBetweenVertices(negative, 1, 2, Queue::kRadixHeap),
+      std::invalid_argument);
+}
+
+TEST(searchAlgs, deltaStepping) {
+  std::size_t const n = 5000;
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 1000);
+  std::vector<std::size_t> offsets(1, 0);
+  std::vector<s21::CsrMatrix::index_type> columns;
+  std::vector<int> values;
+  for (std::size_t i = 0; i < n; i++) {
+    std::set<s21::CsrMatrix::index_type> row;
+    for (int k = 0; k < 6; k++) {
+      row.insert((s21::CsrMatrix::index_type)vertex(gen));
+    }
+    for (auto j : row) {
+      columns.push_back(j);
+      values.push_back(weight(gen));
+    }
+    offsets.push_back(columns.size());
+  }
+  s21::Graph const weighted(s21::CsrMatrix(n, n, offsets, columns, values));
+  s21::GraphAlgoritms ga;
+  s21::ThreadPool pool(4);
+  for (int start : {1, 2500, 4999}) {
+    auto const expected = ga.getShortestPathsFromVertex(weighted, start);
+    EXPECT_EQ(ga.deltaSteppingShortestPaths(weighted, start, &pool),
+              expected);
+    EXPECT_EQ(ga.deltaSteppingShortestPaths(weighted, start, &pool, 1),
+              expected);
+    EXPECT_EQ(ga.deltaSteppingShortestPaths(weighted, start, &pool, 5000),
+              expected);
+    // A ring of ceil(1000 / 7) + 1 buckets wraps many times.
+    EXPECT_EQ(ga.deltaSteppingShortestPaths(weighted, start, &pool, 7),
+              expected);
+  }
+  std::vector<double> real_values;
+  for (int w : values) real_values.push_back(w * 0.37);
+  s21::BasicGraph<double> const real(
+      s21::BasicCsrMatrix<double>(n, n, offsets, columns, real_values));
+  // The tiny deltas are raised, not given a ring of 10^300 buckets.
+  for (double delta : {0.0, 0.9, 50.0, 1e-300,
+                       std::numeric_limits<double>::denorm_min()}) {
+    EXPECT_EQ(ga.deltaSteppingShortestPaths(real, 3, &pool, delta),
+              ga.getShortestPathsFromVertex(real, 3));
+  }
+  EXPECT_EQ(ga.getShortestPathsFromVertex(weighted, 7)[6], 0);
+  s21::Graph heavy(3);
+  heavy(0, 1) = std::numeric_limits<int>::max();
+  heavy(1, 2) = 1;
+  EXPECT_EQ(ga.deltaSteppingShortestPaths(heavy, 1, &pool, 1),
+            ga.getShortestPathsFromVertex(heavy, 1));
+  EXPECT_THROW(ga.deltaSteppingShortestPaths(weighted, 1, &pool, -1),
+               std::invalid_argument);
+}
+
+TEST(searchAlgs, bidirectionalDijkstra) {
+  std::size_t const n = 300;
+  s21::Graph g(n);
+  std::mt19937 gen(47);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 50);
+  for (int k = 0; k < 1200; k++) g(vertex(gen), vertex(gen)) = weight(gen);
+  g.ToSparse();
+  s21::Graph const& graph = g;
+  s21::GraphAlgoritms ga;
+  s21::SearchWorkspace workspace;
+  for (int u = 1; u <= (int)n; u += 11) {
+    auto const expected = ga.getShortestPathsFromVertex(graph, u);
+    for (int v = 1; v <= (int)n; v += 5) {
+      auto const path = ga.bidirectionalShortestPath(graph, u, v, &workspace);
+      ASSERT_EQ(path.distance, expected[(std::size_t)v - 1]);
+      if (path.distance < 0) {
+        EXPECT_TRUE(path.vertices.empty());
+        continue;
+      }
+      EXPECT_EQ(path.vertices.front(), u);
+      EXPECT_EQ(path.vertices.back(), v);
+      int length = 0;
+      for (std::size_t k = 1; k < path.vertices.size(); k++) {
+        length += graph(path.vertices[k - 1] - 1, path.vertices[k] - 1);
+      }
+      EXPECT_EQ(length, path.distance);
+    }
+  }
+}
+
+TEST(searchAlgs, altLandmarks) {
+  std::size_t const n = 400;
+  s21::Graph g(n);
+  std::mt19937 gen(53);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 40);
+  for (int k = 0; k < 1600; k++) g(vertex(gen), vertex(gen)) = weight(gen);
+  g.ToSparse();
+  s21::Graph const& graph = g;
+  s21::GraphAlgoritms ga;
+  s21::Landmarks const landmarks = ga.selectLandmarks(graph, 6);
+  EXPECT_EQ(landmarks.GetCount(), 6u);
+  EXPECT_EQ(landmarks.GetGraphVersion(), graph.Version());
+
+  landmarks.Save("test_landmarks.bin");
+  s21::Landmarks loaded;
+  loaded.Load("test_landmarks.bin");
+  EXPECT_EQ(loaded.GetLandmarks(), landmarks.GetLandmarks());
+
+  s21::SearchWorkspace workspace;
+  for (int u = 1; u <= (int)n; u += 23) {
+    auto const expected = ga.getShortestPathsFromVertex(graph, u);
+    for (int v = 1; v <= (int)n; v += 9) {
+      auto const distance = expected[(std::size_t)v - 1];
+      if (distance >= 0) {
+        EXPECT_LE(loaded.LowerBound((std::size_t)u - 1, (std::size_t)v - 1),
+                  distance);
+      }
+      auto const path = ga.altShortestPath(graph, loaded, u, v, &workspace);
+      ASSERT_EQ(path.distance, distance);
+      if (distance < 0) continue;
+      EXPECT_EQ(path.vertices.front(), u);
+      EXPECT_EQ(path.vertices.back(), v);
+    }
+  }
+
+  s21::Graph other(3);
+  EXPECT_THROW(ga.altShortestPath(other, loaded, 1, 2),
+               std::invalid_argument);
+
+  // A copy, reordered or not, has the same content and keeps fitting; any
+  // change to a weight makes the tables stale until they are selected
+  // again.
+  s21::Graph copy;
+  copy = graph;
+  EXPECT_GT(copy.Version(), graph.Version());
+  EXPECT_NO_THROW(ga.altShortestPath(copy, loaded, 1, 2));
+  copy.Reorder(s21::VertexOrder::kReverseCuthillMcKee);
+  EXPECT_EQ(copy.Fingerprint(), graph.Fingerprint());
+  EXPECT_TRUE(loaded.Fits(copy));
+  std::size_t to = 0;
+  while (graph(0, to) == 0) to++;
+  g.SetWeight(0, to, graph(0, to) + 1);
+  EXPECT_THROW(ga.altShortestPath(graph, loaded, 1, 2),
+               std::invalid_argument);
+  s21::Landmarks const updated = ga.selectLandmarks(graph, 6);
+  EXPECT_EQ(ga.altShortestPath(graph, updated, 1, (int)to + 1).distance,
+            ga.getShortestPath(graph, 1, (int)to + 1).distance);
+  g(0, to) = graph(0, to) + 1;
+  EXPECT_THROW(ga.altShortestPath(graph, updated, 1, 2),
+               std::invalid_argument);
+  s21::BasicLandmarks<double> wrong_type;
+  EXPECT_THROW(wrong_type.Load("test_landmarks.bin"), std::runtime_error);
+}
+
+TEST(searchAlgs, altLandmarksOtherGraph) {
+  // Same size, arcs and version, different weights: the bounds of a are
+  // not valid for b, where 1 -> 4 costs 2 instead of 3.
+  s21::Graph a(4), b(4);
+  int const weights_a[] = {1, 1, 1, 10};
+  int const weights_b[] = {10, 10, 10, 2};
+  std::size_t const from[] = {0, 1, 2, 0}, to[] = {1, 2, 3, 3};
+  for (int k = 0; k < 4; k++) {
+    a(from[k], to[k]) = weights_a[k];
+    b(from[k], to[k]) = weights_b[k];
+  }
+  ASSERT_EQ(a.Version(), b.Version());
+  s21::GraphAlgoritms ga;
+  s21::Landmarks const landmarks = ga.selectLandmarks(a, 2);
+  landmarks.Save("test_landmarks.bin");
+  EXPECT_FALSE(landmarks.Fits(b));
+  EXPECT_THROW(ga.altShortestPath(b, landmarks, 1, 4), std::invalid_argument);
+
+  s21::Landmarks loaded;
+  EXPECT_THROW(loaded.Load("test_landmarks.bin", b), std::runtime_error);
+  EXPECT_EQ(loaded.GetCount(), 0u);
+  s21::Graph same = a;
+  same.Reorder(s21::VertexOrder::kDegree);
+  loaded.Load("test_landmarks.bin", same);
+  EXPECT_EQ(loaded.GetGraphFingerprint(), a.Fingerprint());
+  EXPECT_EQ(ga.altShortestPath(same, loaded, 1, 4).distance, 3);
+  EXPECT_EQ(ga.altShortestPath(b, ga.selectLandmarks(b, 2), 1, 4).distance,
+            2);
+}
+
+TEST(searchAlgs, multiSourceBfs) {
+  std::size_t const n = 2000;
+  s21::Graph g = RandomSparseGraph(n, 4, 9);
+  s21::GraphAlgoritms ga;
+
+  // 100 sources make a full batch of 64 and a partial one.
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int> vertex(1, (int)n);
+  std::vector<int> sources;
+  for (int k = 0; k < 100; k++) sources.push_back(vertex(gen));
+  sources.push_back(sources.front());
+  s21::Matrix distances = ga.multiSourceBreadthFirstSearch(g, sources);
+  ASSERT_EQ(distances.GetRows(), sources.size());
+  for (std::size_t s = 0; s < sources.size(); s += 7) {
+    auto const tree = ga.breadthFirstSearchTree(g, sources[s]);
+    for (std::size_t v = 0; v < n; v++) {
+      EXPECT_EQ(distances(s, v), tree.level[v]);
+    }
+  }
+  for (std::size_t v = 0; v < n; v++) {
+    EXPECT_EQ(distances(100, v), distances(0, v));
+  }
+  EXPECT_THROW(ga.multiSourceBreadthFirstSearch(g, {1, (int)n + 1}),
+               std::out_of_range);
+}
+
 TEST(travelingSalesmanProblem, naiveSolve_1) {
   s21::Graph my_graph;
   my_graph.LoadGraphFromFile("tests/test_graph_2.txt");
@@ -287,6 +1750,83 @@ TEST(travelingSalesmanProblem, antColony_2) {
   validate_path(res, my_graph);
 }
 
+TEST(travelingSalesmanProblem, antColony_float) {
+  // Every arc weighs 0.5, so every tour of the 7 cities is 3.5 long.
+  s21::BasicGraph<float> my_graph;
+  my_graph.LoadGraphFromFile("tests/test_graph_3.txt");
+  my_graph.ToDense();
+  for (std::size_t i = 0; i < 7; i++) {
+    for (std::size_t j = 0; j < 7; j++) {
+      if (my_graph(i, j) != 0) my_graph(i, j) = 0.5f;
+    }
+  }
+  s21::tsm::AntColony ac;
+  s21::tsm::TsmResult res = ac.FindOptimalPath(my_graph);
+
+  ASSERT_EQ(res.vertices.size(), 7u);
+  EXPECT_DOUBLE_EQ(res.distance, 3.5);
+  std::set<int> cities(res.vertices.begin(), res.vertices.end());
+  EXPECT_EQ(cities.size(), 7u);
+}
+
+TEST(travelingSalesmanProblem, antColony_seeded) {
+  // Runs drawing from the random device would hardly ever find the same
+  // tour of 30 cities twice.
+  s21::Graph my_graph = randomCompleteGraph(30, 1);
+  s21::tsm::AntColony first(7);
+  s21::tsm::AntColony second(7);
+  s21::tsm::TsmResult res = first.FindOptimalPath(my_graph);
+
+  validate_path(res, my_graph);
+  EXPECT_EQ(second.FindOptimalPath(my_graph).vertices, res.vertices);
+}
+
+TEST(travelingSalesmanProblem, antColony_freshTours) {
+  // Every run measures the tour it walks, not the sum of the ant's tours.
+  s21::Graph my_graph = randomCompleteGraph(12, 2);
+  s21::BasicMatrix<float> proximity, pheromone;
+  AntColonySteps::Prepare(my_graph, &proximity, &pheromone);
+  AntColonySteps colony(3);
+  std::vector<AntColonySteps::Ant> ants(12, AntColonySteps::Ant(12));
+  for (int run = 0; run < 2; run++) {
+    colony.SimulateAnts(my_graph, proximity, ants, pheromone);
+    for (const AntColonySteps::Ant& ant : ants) {
+      validate_path({ant.path, ant.distance}, my_graph);
+    }
+  }
+}
+
+TEST(travelingSalesmanProblem, antColony_chooseCity) {
+  AntColonySteps colony(4);
+  std::vector<float> const attraction = {0.f, 0.1f, 0.f, 0.2f, 0.3f, 0.f};
+  // A normalised prefix array would take city 0 for a draw of 0 and run
+  // past the end for a draw its rounded last sum stays below.
+  EXPECT_EQ(colony.ChooseCity(attraction, 0.f), 1);
+  EXPECT_EQ(colony.ChooseCity(attraction, 0.1f), 1);
+  EXPECT_EQ(colony.ChooseCity(attraction, 0.25f), 3);
+  EXPECT_EQ(colony.ChooseCity(attraction, 0.6f), 4);
+  EXPECT_EQ(colony.ChooseCity(attraction, 0.7f), 4);
+}
+
+TEST(travelingSalesmanProblem, antColony_stuckAnts) {
+  // An ant that got stuck leaves no trail, in particular no zero one.
+  AntColonySteps colony(5);
+  s21::BasicMatrix<float> pheromone(3, 3);
+  for (std::size_t i = 0; i < 3; i++) {
+    for (std::size_t j = 0; j < 3; j++) pheromone(i, j) = 0.2f;
+  }
+  std::vector<AntColonySteps::Ant> ants(2, AntColonySteps::Ant(3));
+  ants[0].path = {0, 1, 2};
+  ants[0].distance = INFINITY;
+  ants[1].path = {2, 0, 1};
+  ants[1].distance = 8;
+  colony.UpdatePheromone(ants, pheromone);
+  EXPECT_FLOAT_EQ(pheromone(1, 2), 0.2f * (1 - 0.64f));
+  EXPECT_FLOAT_EQ(pheromone(2, 1), 0.2f * (1 - 0.64f));
+  EXPECT_FLOAT_EQ(pheromone(0, 1), 240.f / 8);
+  EXPECT_FLOAT_EQ(pheromone(0, 2), 240.f / 8);
+}
+
 TEST(travelingSalesmanProblem, naiveSolve_no_path) {
   s21::Graph my_graph;
   my_graph.LoadGraphFromFile("tests/empty_graph.txt");